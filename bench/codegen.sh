@@ -0,0 +1,114 @@
+#!/usr/bin/env bash
+# codegen.sh
+#
+# checks that roam::range loops compile to the same loops as raw for loops
+# every <kernel>_raw / <kernel>_range pair in codegen_kernels.cpp is compiled at -O2 and -O3
+# with each compiler found, disassembled with objdump and compared loop by loop:
+#   - a loop is a backward jump, its body the instructions from the jump target to the jump,
+#     with no return in between
+#   - the hot loop is the largest vectorized loop, or the largest loop if none is vectorized
+#   - the range kernel fails if its hot loop has more instructions than the raw one, or if
+#     the raw kernel vectorizes and the range kernel does not. when only the range kernel
+#     vectorizes, its largest scalar loop is compared with the raw hot loop
+# usage: bench/codegen.sh [ compiler ... ]      ( default: g++ clang++, missing ones skipped )
+# exit code is the number of failed comparisons
+#=============================================================================
+
+set -u
+
+here="$( cd "$( dirname "$0" )" && pwd )"
+tmp="$( mktemp -d )"
+trap 'rm -rf "$tmp"' EXIT
+
+kernels="sum saxpy strided_copy traced_sum"
+compilers="${*:-g++ clang++}"
+
+# prints "<vectorized 0|1> <hot loop instructions> <loop count> <largest scalar loop instructions>"
+# for one function
+analyze()
+{
+    objdump -d --no-show-raw-insn --disassemble="$2" "$1" | awk '
+        function hex( s,    i, v ) {   # portable, mawk has no strtonum
+            v = 0
+            for ( i = 1; i <= length( s ); i++ ) v = v * 16 + index( "0123456789abcdef", substr( s, i, 1 ) ) - 1
+            return v
+        }
+        /^ *[0-9a-f]+:\t/ {
+            addr = $1
+            sub( /:$/, "", addr )
+            addr = hex( addr )
+            sub( /^ *[0-9a-f]+:\t/, "" )
+            split( $0, f, /[ \t]+/ )
+            n++
+            at[ n ] = addr
+            mn[ n ] = f[ 1 ]
+            line[ n ] = $0
+        }
+        END {
+            loops = 0
+            hot_vec = 0; hot_any = 0; hot_scalar = 0
+            for ( j = 1; j <= n; j++ ) {
+                if ( mn[ j ] !~ /^j/ || split( line[ j ], t, /[ \t]+/ ) < 2 ) continue
+                target = hex( t[ 2 ] )
+                if ( target > at[ j ] ) continue
+                size = 0; packed = 0; exits = 0
+                for ( i = 1; i <= n; i++ ) {
+                    if ( at[ i ] < target || at[ i ] > at[ j ] ) continue
+                    size++
+                    m = mn[ i ]
+                    if ( m ~ /^ret/ ) exits = 1
+                    if ( line[ i ] ~ /%[xyz]mm/ && ( m ~ /p[sd]$/ || m ~ /^v?p[a-z]/ || m ~ /^v?movdq/ ) ) packed = 1
+                }
+                # a backward jump over a return is a shared exit block, not a loop
+                if ( exits ) continue
+                loops++
+                if ( size > hot_any ) hot_any = size
+                if ( packed && size > hot_vec ) hot_vec = size
+                if ( !packed && size > hot_scalar ) hot_scalar = size
+            }
+            if ( hot_vec > 0 ) print 1, hot_vec, loops, hot_scalar
+            else print 0, hot_any, loops, hot_scalar
+        }'
+}
+
+failures=0
+for cxx in $compilers; do
+    if ! command -v "$cxx" > /dev/null 2>&1; then
+        echo "skip: $cxx not found"
+        continue
+    fi
+    for opt in -O2 -O3; do
+        obj="$tmp/kernels_${cxx//+/x}${opt}.o"
+        if ! "$cxx" -std=c++17 "$opt" -DNDEBUG -c "$here/codegen_kernels.cpp" -o "$obj"; then
+            echo "FAIL: $cxx $opt does not compile the kernels"
+            failures=$(( failures + 1 ))
+            continue
+        fi
+        for k in $kernels; do
+            read -r raw_vec raw_size raw_loops _ <<< "$( analyze "$obj" "${k}_raw" )"
+            read -r rng_vec rng_size rng_loops rng_scalar <<< "$( analyze "$obj" "${k}_range" )"
+            status="ok"
+            if [ -z "$raw_size" ] || [ -z "$rng_size" ] || [ "$raw_loops" -eq 0 ]; then
+                echo "FAIL: $cxx $opt no loop found in ${k}_raw / ${k}_range"
+                failures=$(( failures + 1 ))
+                continue
+            fi
+            cmp_size="$rng_size"
+            if [ "$raw_vec" -eq 0 ] && [ "$rng_vec" -eq 1 ]; then
+                cmp_size="$rng_scalar"
+            fi
+            if [ "$cmp_size" -gt "$raw_size" ]; then
+                status="FAIL: range hot loop is larger"
+            fi
+            if [ "$raw_vec" -eq 1 ] && [ "$rng_vec" -eq 0 ]; then
+                status="FAIL: range loop is not vectorized"
+            fi
+            printf "%-8s %-4s %-14s raw: %2d insns vec=%d loops=%d   range: %2d insns vec=%d loops=%d   %s\n" \
+                "$cxx" "$opt" "$k" "$raw_size" "$raw_vec" "$raw_loops" "$rng_size" "$rng_vec" "$rng_loops" "$status"
+            if [ "$status" != "ok" ]; then
+                failures=$(( failures + 1 ))
+            fi
+        done
+    done
+done
+exit "$failures"
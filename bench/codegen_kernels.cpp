@@ -0,0 +1,82 @@
+// codegen_kernels.cpp
+//
+// reference kernels written once as raw loops and once with roam::range, compiled to an
+// object file by codegen.sh which compares the loop bodies of each <kernel>_raw / <kernel>_range
+// pair. extern "C" keeps the symbol names stable across compilers
+//=============================================================================
+
+#include "../range.h"
+#include "../range_telemetry.h"
+
+#include <cstddef>
+
+extern "C"
+{
+
+// sum
+auto sum_raw( int const* a, int const n ) -> int
+{
+    auto s = 0;
+    for ( auto i = 0; i < n; ++i ) {
+        s += a[ i ];
+    }
+    return s;
+}
+auto sum_range( int const* a, int const n ) -> int
+{
+    auto s = 0;
+    for ( auto const i : roam::range{ n } ) {
+        s += a[ i ];
+    }
+    return s;
+}
+
+// saxpy, y = a * x + y
+void saxpy_raw( float const a, float const* __restrict x, float* __restrict y, int const n )
+{
+    for ( auto i = 0; i < n; ++i ) {
+        y[ i ] = a * x[ i ] + y[ i ];
+    }
+}
+void saxpy_range( float const a, float const* __restrict x, float* __restrict y, int const n )
+{
+    for ( auto const i : roam::range{ n } ) {
+        y[ i ] = a * x[ i ] + y[ i ];
+    }
+}
+
+// strided copy, gather every 'step'th element
+void strided_copy_raw( float const* __restrict src, float* __restrict dst, int const n, int const step )
+{
+    auto k = 0;
+    for ( auto i = 0; i < n; i += step ) {
+        dst[ k++ ] = src[ i ];
+    }
+}
+void strided_copy_range( float const* __restrict src, float* __restrict dst, int const n, int const step )
+{
+    auto k = 0;
+    for ( auto const i : roam::range{ 0, n, step } ) {
+        dst[ k++ ] = src[ i ];
+    }
+}
+
+// sum through traced( range ), telemetry disabled must leave the plain range loop
+auto traced_sum_raw( int const* a, int const n ) -> int
+{
+    auto s = 0;
+    for ( auto i = 0; i < n; ++i ) {
+        s += a[ i ];
+    }
+    return s;
+}
+auto traced_sum_range( int const* a, int const n ) -> int
+{
+    auto s = 0;
+    for ( auto const i : roam::traced< roam::telemetry::disabled >( roam::range{ n } ) ) {
+        s += a[ i ];
+    }
+    return s;
+}
+
+} // extern "C"
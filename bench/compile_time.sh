@@ -0,0 +1,127 @@
+#!/usr/bin/env bash
+# compile_time.sh
+#
+# compile time budget of range.h, the cost every translation unit including it pays
+# two translation units are measured: one that only includes range.h and one with typical use
+# ( forward, strided and reversed loops, indexing, min_range )
+#   - lines:  preprocessed lines of the use TU, what the compiler has to tokenize and parse
+#   - parse:  best of 5 -fsyntax-only wall times of the use TU, in ms
+#   - inst:   template instantiations of the use TU, InstantiateClass / InstantiateFunction events
+#             of clang -ftime-trace when clang++ is found, otherwise the number of instantiated
+#             functions g++ emits at -O0 ( a proxy, reported as inst~ )
+# the check fails when a measure exceeds its budget, override with LINES_BUDGET, PARSE_BUDGET_MS
+# and INST_BUDGET. parse time depends on the machine, its budget is loose on purpose and catches
+# another heavy standard header rather than small drifts. most of the lines are <iterator>, which
+# range.h needs for the iterator tags
+# usage: bench/compile_time.sh [ compiler ]      ( default: clang++ if found, else g++ )
+# exit code is the number of exceeded budgets
+#=============================================================================
+
+set -u
+
+here="$( cd "$( dirname "$0" )" && pwd )"
+tmp="$( mktemp -d )"
+trap 'rm -rf "$tmp"' EXIT
+
+lines_budget="${LINES_BUDGET:-21000}"
+parse_budget="${PARSE_BUDGET_MS:-600}"
+inst_budget="${INST_BUDGET:-60}"
+
+cxx="${1:-}"
+if [ -z "$cxx" ]; then
+    if command -v clang++ > /dev/null 2>&1; then cxx=clang++; else cxx=g++; fi
+fi
+if ! command -v "$cxx" > /dev/null 2>&1; then
+    echo "FAIL: $cxx not found"
+    exit 1
+fi
+flags="-std=c++17 -I$here/.."
+inst_label="inst"
+case "${cxx##*/}" in
+    *clang*) ;;
+    *) inst_label="inst~" ;;
+esac
+
+cat > "$tmp/include.cpp" <<'EOF'
+#include "range.h"
+EOF
+cat > "$tmp/use.cpp" <<'EOF'
+#include "range.h"
+
+#include <cstddef>
+
+struct buffer
+{
+    auto size() const -> std::size_t { return 64; }
+};
+
+auto use( int const n ) -> int
+{
+    auto s = 0;
+    for ( auto const i : roam::range{ n } ) {
+        s += i;
+    }
+    for ( auto const i : roam::range{ 0, n, 2 }.reversed() ) {
+        s -= i;
+    }
+    for ( auto const i : roam::min_range( buffer{}, std::size_t{ 16 } ) ) {
+        s += static_cast< int >( i );
+    }
+    return s + roam::range{ n }[ -1 ];
+}
+EOF
+
+# best of 5 wall times of -fsyntax-only, in ms
+parse_ms()
+{
+    local best=""
+    for _ in 1 2 3 4 5; do
+        local a b
+        a=$( date +%s%N )
+        $cxx $flags -fsyntax-only "$1" || return 1
+        b=$( date +%s%N )
+        local d=$(( ( b - a ) / 1000000 ))
+        if [ -z "$best" ] || [ "$d" -lt "$best" ]; then best=$d; fi
+    done
+    echo "$best"
+}
+
+# template instantiations of one TU
+instantiations()
+{
+    if [ "$inst_label" = "inst" ]; then
+        $cxx $flags -c -ftime-trace -ftime-trace-granularity=0 "$1" -o "$tmp/inst.o" || return 1
+        grep -o '"name":"Instantiate\(Class\|Function\)"' "$tmp/inst.json" | wc -l
+    else
+        $cxx $flags -O0 -c "$1" -o "$tmp/inst.o" || return 1
+        nm -C "$tmp/inst.o" | grep -c ' [TW] .*<' || true
+    fi
+}
+
+failures=0
+for tu in include use; do
+    if ! $cxx $flags -E -P "$tmp/$tu.cpp" -o "$tmp/$tu.ii" || ! ms=$( parse_ms "$tmp/$tu.cpp" ) || ! inst=$( instantiations "$tmp/$tu.cpp" ); then
+        echo "FAIL: $cxx does not compile $tu.cpp"
+        exit 1
+    fi
+    lines=$( grep -c . "$tmp/$tu.ii" )
+    printf "%-8s %-8s lines: %6d   parse: %5d ms   %-5s %4d\n" "$cxx" "$tu" "$lines" "$ms" "$inst_label:" "$inst"
+done
+
+# budgets apply to the use TU, the last one measured
+if [ "$lines" -gt "$lines_budget" ]; then
+    echo "FAIL: $lines preprocessed lines, budget $lines_budget"
+    failures=$(( failures + 1 ))
+fi
+if [ "$ms" -gt "$parse_budget" ]; then
+    echo "FAIL: parse $ms ms, budget $parse_budget ms"
+    failures=$(( failures + 1 ))
+fi
+if [ "$inst" -gt "$inst_budget" ]; then
+    echo "FAIL: $inst instantiations, budget $inst_budget"
+    failures=$(( failures + 1 ))
+fi
+if [ "$failures" -eq 0 ]; then
+    echo "ok: within budget ( lines $lines_budget, parse $parse_budget ms, $inst_label $inst_budget )"
+fi
+exit "$failures"
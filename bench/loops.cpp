@@ -0,0 +1,324 @@
+// loops.cpp
+//
+// raw for loops against roam::range forward, reverse and stepped iteration, per element type
+// and trip count. every kernel stores the loop values to memory, so nothing folds to a closed
+// form and the loop itself is what is measured. a loop counts as vectorized when it beats
+// the same raw loop compiled with vectorization disabled by 'vector_gain'.
+// results are one json object per line; with a baseline, a range / raw ratio that grew past
+// the threshold or a range loop that stopped vectorizing is a regression ( exit code 1 ).
+// timings of loops this short are noisy, compare on a quiet machine and keep the threshold loose
+// build: g++ -std=c++17 -O2 -DNDEBUG bench/loops.cpp -o loops_bench
+//        g++ -std=c++17 -O2 bench/loops.cpp -o loops_bench_asserted       ( range checks enabled )
+// usage: loops_bench [ --baseline bench/loops_baseline.json ] [ --threshold 1.5 ]
+//        loops_bench > bench/loops_baseline.json                             ( refresh the baseline )
+//=============================================================================
+
+#include "../range.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#if defined( __clang__ )
+#define ROAM_BENCH_NOINLINE __attribute__( ( noinline ) )
+#define ROAM_BENCH_SCALAR_FN
+#define ROAM_BENCH_SCALAR_LOOP _Pragma( "clang loop vectorize( disable ) interleave( disable )" )
+#elif defined( __GNUC__ )
+#define ROAM_BENCH_NOINLINE __attribute__( ( noinline ) )
+#define ROAM_BENCH_SCALAR_FN __attribute__( ( optimize( "no-tree-vectorize" ) ) )
+#define ROAM_BENCH_SCALAR_LOOP
+#else
+#define ROAM_BENCH_NOINLINE
+#define ROAM_BENCH_SCALAR_FN
+#define ROAM_BENCH_SCALAR_LOOP
+#endif
+
+namespace
+{
+
+auto constexpr step = 3;
+auto constexpr vector_gain = 1.5;
+auto constexpr samples = 9;
+
+// kernels, 'n' comes in at run time so trip counts are not known to the compiler
+template < typename ty_t >
+ROAM_BENCH_NOINLINE auto raw_forward( ty_t* out, ty_t const n ) -> std::size_t
+{
+    auto k = std::size_t{ 0 };
+    for ( auto v = ty_t{ 0 }; v < n; ++v ) {
+        out[ k++ ] = v;
+    }
+    return k;
+}
+template < typename ty_t >
+ROAM_BENCH_NOINLINE auto range_forward( ty_t* out, ty_t const n ) -> std::size_t
+{
+    auto k = std::size_t{ 0 };
+    for ( auto const v : roam::range< ty_t >{ n } ) {
+        out[ k++ ] = v;
+    }
+    return k;
+}
+template < typename ty_t >
+ROAM_BENCH_NOINLINE ROAM_BENCH_SCALAR_FN auto scalar_forward( ty_t* out, ty_t const n ) -> std::size_t
+{
+    auto k = std::size_t{ 0 };
+    ROAM_BENCH_SCALAR_LOOP
+    for ( auto v = ty_t{ 0 }; v < n; ++v ) {
+        out[ k++ ] = v;
+    }
+    return k;
+}
+
+template < typename ty_t >
+ROAM_BENCH_NOINLINE auto raw_reverse( ty_t* out, ty_t const n ) -> std::size_t
+{
+    auto k = std::size_t{ 0 };
+    for ( auto v = n; v > ty_t{ 0 }; ) {
+        v -= ty_t{ 1 };
+        out[ k++ ] = v;
+    }
+    return k;
+}
+template < typename ty_t >
+ROAM_BENCH_NOINLINE auto range_reverse( ty_t* out, ty_t const n ) -> std::size_t
+{
+    auto k = std::size_t{ 0 };
+    auto const r = roam::range< ty_t >{ n };
+    for ( auto it = r.rbegin(); it != r.rend(); ++it ) {
+        out[ k++ ] = *it;
+    }
+    return k;
+}
+template < typename ty_t >
+ROAM_BENCH_NOINLINE ROAM_BENCH_SCALAR_FN auto scalar_reverse( ty_t* out, ty_t const n ) -> std::size_t
+{
+    auto k = std::size_t{ 0 };
+    ROAM_BENCH_SCALAR_LOOP
+    for ( auto v = n; v > ty_t{ 0 }; ) {
+        v -= ty_t{ 1 };
+        out[ k++ ] = v;
+    }
+    return k;
+}
+
+template < typename ty_t >
+ROAM_BENCH_NOINLINE auto raw_stepped( ty_t* out, ty_t const n ) -> std::size_t
+{
+    auto k = std::size_t{ 0 };
+    for ( auto v = ty_t{ 0 }; v < n; v += ty_t{ step } ) {
+        out[ k++ ] = v;
+    }
+    return k;
+}
+template < typename ty_t >
+ROAM_BENCH_NOINLINE auto range_stepped( ty_t* out, ty_t const n ) -> std::size_t
+{
+    auto k = std::size_t{ 0 };
+    for ( auto const v : roam::range< ty_t >{ ty_t{ 0 }, n, ty_t{ step } } ) {
+        out[ k++ ] = v;
+    }
+    return k;
+}
+template < typename ty_t >
+ROAM_BENCH_NOINLINE ROAM_BENCH_SCALAR_FN auto scalar_stepped( ty_t* out, ty_t const n ) -> std::size_t
+{
+    auto k = std::size_t{ 0 };
+    ROAM_BENCH_SCALAR_LOOP
+    for ( auto v = ty_t{ 0 }; v < n; v += ty_t{ step } ) {
+        out[ k++ ] = v;
+    }
+    return k;
+}
+
+template < typename ty_t >
+using kernel_t = auto ( * )( ty_t*, ty_t ) -> std::size_t;
+
+template < typename ty_t >
+auto time_kernel( kernel_t< ty_t > const fn, std::vector< ty_t >& out, std::size_t const n ) -> double
+{   // @return ns per loop iteration for one sample of about 2^22 iterations
+    auto const reps = ( std::size_t{ 1 } << 22 ) / n + 1;
+    auto iterations = std::size_t{ 0 };
+    auto const t0 = std::chrono::steady_clock::now();
+    for ( [[maybe_unused]] auto const rep : roam::range{ reps } )
+    {
+        iterations += fn( out.data(), static_cast< ty_t >( n ) );
+    }
+    auto const t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration< double, std::nano >( t1 - t0 ).count() / static_cast< double >( iterations );
+}
+
+struct result
+{
+    std::string type;
+    std::string kind;
+    std::size_t n{};
+    double raw_ns{};
+    double range_ns{};
+    bool raw_vectorized{};
+    bool range_vectorized{};
+};
+
+template < typename ty_t >
+void run_type( char const* const type, std::vector< result >& results )
+{
+    struct kind
+    {
+        char const* name;
+        kernel_t< ty_t > raw;
+        kernel_t< ty_t > range;
+        kernel_t< ty_t > scalar;
+    };
+    kind const kinds[] = {
+        { "forward", &raw_forward< ty_t >, &range_forward< ty_t >, &scalar_forward< ty_t > },
+        { "reverse", &raw_reverse< ty_t >, &range_reverse< ty_t >, &scalar_reverse< ty_t > },
+        { "stepped", &raw_stepped< ty_t >, &range_stepped< ty_t >, &scalar_stepped< ty_t > },
+    };
+    for ( auto const n : { std::size_t{ 16 }, std::size_t{ 100 }, std::size_t{ 4096 }, std::size_t{ 65536 } } )
+    {
+        // trip counts the type can count to, int8 stops at 100
+        if ( static_cast< double >( n ) > static_cast< double >( std::numeric_limits< ty_t >::max() ) ) {
+            continue;
+        }
+        auto out = std::vector< ty_t >( n );
+        for ( auto const& k : kinds )
+        {
+            // best of 'samples', the three loops interleaved so drift in clock speed hits all alike
+            auto scalar_ns = 1e300;
+            auto r = result{ type, k.name, n, 1e300, 1e300 };
+            for ( [[maybe_unused]] auto const _ : roam::range{ samples } )
+            {
+                scalar_ns = std::min( scalar_ns, time_kernel< ty_t >( k.scalar, out, n ) );
+                r.raw_ns = std::min( r.raw_ns, time_kernel< ty_t >( k.raw, out, n ) );
+                r.range_ns = std::min( r.range_ns, time_kernel< ty_t >( k.range, out, n ) );
+            }
+            r.raw_vectorized = r.raw_ns * vector_gain < scalar_ns;
+            r.range_vectorized = r.range_ns * vector_gain < scalar_ns;
+            results.push_back( r );
+        }
+    }
+}
+
+auto compiler() -> std::string
+{
+#if defined( __clang__ )
+    return "clang " __clang_version__;
+#elif defined( __GNUC__ )
+    return "gcc " __VERSION__;
+#else
+    return "unknown";
+#endif
+}
+
+#ifdef NDEBUG
+auto constexpr ndebug = true;
+#else
+auto constexpr ndebug = false;
+#endif
+
+void print( result const& r )
+{
+    std::printf( "{ \"type\": \"%s\", \"kind\": \"%s\", \"n\": %zu, \"ndebug\": %s, \"raw_ns\": %.4f, \"range_ns\": %.4f, "
+                 "\"ratio\": %.3f, \"raw_vectorized\": %s, \"range_vectorized\": %s }\n",
+                 r.type.c_str(), r.kind.c_str(), r.n, ndebug ? "true" : "false", r.raw_ns, r.range_ns, r.range_ns / r.raw_ns,
+                 r.raw_vectorized ? "true" : "false", r.range_vectorized ? "true" : "false" );
+}
+
+auto read_baseline( char const* const path ) -> std::vector< result >
+{   // @return results from a file written by this program, one json object per line
+    auto ret = std::vector< result >{};
+    auto* const f = std::fopen( path, "r" );
+    if ( f == nullptr ) {
+        std::fprintf( stderr, "can not open baseline %s\n", path );
+        std::exit( 2 );
+    }
+    char line[ 512 ];
+    while ( std::fgets( line, sizeof( line ), f ) != nullptr )
+    {
+        char type[ 32 ] = {};
+        char kind[ 32 ] = {};
+        char nd[ 8 ] = {};
+        char rawv[ 8 ] = {};
+        char rangev[ 8 ] = {};
+        auto r = result{};
+        auto ratio = 0.0;
+        if ( std::sscanf( line, "{ \"type\": \"%31[^\"]\", \"kind\": \"%31[^\"]\", \"n\": %zu, \"ndebug\": %7[a-z], \"raw_ns\": %lf, \"range_ns\": %lf, "
+                                "\"ratio\": %lf, \"raw_vectorized\": %7[a-z], \"range_vectorized\": %7[a-z] }",
+                          type, kind, &r.n, nd, &r.raw_ns, &r.range_ns, &ratio, rawv, rangev ) != 9 ) {
+            continue;
+        }
+        if ( ( std::strcmp( nd, "true" ) == 0 ) != ndebug ) {
+            std::fprintf( stderr, "baseline %s was measured with%s NDEBUG, this build is%s\n", path, ndebug ? "out" : "", ndebug ? "" : " not" );
+            std::exit( 2 );
+        }
+        r.type = type;
+        r.kind = kind;
+        r.raw_vectorized = std::strcmp( rawv, "true" ) == 0;
+        r.range_vectorized = std::strcmp( rangev, "true" ) == 0;
+        ret.push_back( r );
+    }
+    std::fclose( f );
+    return ret;
+}
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+    char const* baseline = nullptr;
+    auto threshold = 1.5;
+    for ( auto i = 1; i < argc; ++i )
+    {
+        if ( std::strcmp( argv[ i ], "--baseline" ) == 0 && i + 1 < argc ) {
+            baseline = argv[ ++i ];
+        }
+        else if ( std::strcmp( argv[ i ], "--threshold" ) == 0 && i + 1 < argc ) {
+            threshold = std::atof( argv[ ++i ] );
+        }
+    }
+
+    auto results = std::vector< result >{};
+    run_type< std::int8_t >( "int8", results );
+    run_type< std::int16_t >( "int16", results );
+    run_type< std::int32_t >( "int32", results );
+    run_type< std::int64_t >( "int64", results );
+    run_type< std::uint32_t >( "uint32", results );
+    run_type< double >( "double", results );
+
+    std::printf( "{ \"compiler\": \"%s\", \"ndebug\": %s, \"threshold\": %.2f }\n", compiler().c_str(), ndebug ? "true" : "false", threshold );
+    for ( auto const& r : results ) {
+        print( r );
+    }
+    if ( baseline == nullptr ) {
+        return 0;
+    }
+
+    // ratios, not absolute times, are compared so a baseline carries across machines
+    auto regressions = 0;
+    for ( auto const& b : read_baseline( baseline ) )
+    {
+        for ( auto const& r : results )
+        {
+            if ( r.type != b.type || r.kind != b.kind || r.n != b.n ) {
+                continue;
+            }
+            auto const was = b.range_ns / b.raw_ns;
+            auto const now = r.range_ns / r.raw_ns;
+            if ( now > was * threshold ) {
+                std::fprintf( stderr, "regression: %s %s n=%zu range / raw %.3f, baseline %.3f\n", r.type.c_str(), r.kind.c_str(), r.n, now, was );
+                ++regressions;
+            }
+            if ( b.range_vectorized && !r.range_vectorized ) {
+                std::fprintf( stderr, "regression: %s %s n=%zu range loop no longer vectorized\n", r.type.c_str(), r.kind.c_str(), r.n );
+                ++regressions;
+            }
+        }
+    }
+    return regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// step.cpp
+//
+// size() / index_of() cost over many small ranges sharing a step, the pattern of tight
+// nested loops where the division in size() is paid once per short inner loop
+// build: g++ -std=c++17 -O2 -DNDEBUG bench/step.cpp -o step_bench
+// usage: step_bench [ step ]
+//=============================================================================
+
+#include "../range.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// the pre fast path size(): a signed division and multiply back for every step
+auto divide_multiply_size( roam::range< int64_t > const& r ) -> std::size_t
+{
+    auto const sz = ( r.stop() - r.start() ) / r.step();
+    auto const v = r.start() + sz * r.step();
+    return static_cast< std::size_t >( v == r.stop() ? sz : sz + 1 );
+}
+
+template < typename fn_t >
+void run( char const* name, std::size_t const ops, fn_t&& fn )
+{
+    auto best = 1e300;
+    auto sink = std::uint64_t{ 0 };
+    for ( [[maybe_unused]] auto const _ : roam::range{ 5 } )
+    {
+        auto const t0 = std::chrono::steady_clock::now();
+        sink += fn();
+        auto const t1 = std::chrono::steady_clock::now();
+        auto const ns = std::chrono::duration< double, std::nano >( t1 - t0 ).count();
+        best = ns < best ? ns : best;
+    }
+    std::printf( "%-34s %8.3f ns/op  ( %llu )\n", name, best / static_cast< double >( ops ), static_cast< unsigned long long >( sink ) );
+}
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+    // the step is read at run time so the compiler can not fold the division
+    auto const step = static_cast< int64_t >( argc > 1 ? std::atoll( argv[ 1 ] ) : 7 );
+    auto constexpr count = std::size_t{ 1 } << 16;
+    auto constexpr frames = 64;
+
+    auto rng = std::mt19937_64{ 1 };
+    auto len = std::uniform_int_distribution< int64_t >{ 0, 16 };
+    auto ranges = std::vector< roam::range< int64_t > >{};
+    auto probes = std::vector< int64_t >{};
+    for ( [[maybe_unused]] auto const _ : roam::range{ count } )
+    {
+        auto const start = static_cast< int64_t >( rng() % 100000 );
+        ranges.emplace_back( start, start + step * len( rng ), step );
+        probes.push_back( start + static_cast< int64_t >( rng() % 64 ) );
+    }
+    auto const ops = count * frames;
+    std::printf( "step %lld, %zu ranges x %d frames\n", static_cast< long long >( step ), count, frames );
+
+    run( "size: divide + multiply back", ops, [&] {
+        auto sum = std::uint64_t{ 0 };
+        for ( [[maybe_unused]] auto const f : roam::range{ frames } )
+        {
+            for ( auto const& r : ranges )
+            {
+                sum += divide_multiply_size( r );
+            }
+        }
+        return sum;
+    } );
+    run( "size: range::size", ops, [&] {
+        auto sum = std::uint64_t{ 0 };
+        for ( [[maybe_unused]] auto const f : roam::range{ frames } )
+        {
+            for ( auto const& r : ranges )
+            {
+                sum += r.size();
+            }
+        }
+        return sum;
+    } );
+    run( "size: precomputed_step", ops, [&] {
+        auto const ps = roam::precomputed_step< int64_t >{ step };
+        auto sum = std::uint64_t{ 0 };
+        for ( [[maybe_unused]] auto const f : roam::range{ frames } )
+        {
+            for ( auto const& r : ranges )
+            {
+                sum += ps.size( r );
+            }
+        }
+        return sum;
+    } );
+    run( "index_of: range::index_of", ops, [&] {
+        auto sum = std::uint64_t{ 0 };
+        for ( [[maybe_unused]] auto const f : roam::range{ frames } )
+        {
+            for ( auto const i : roam::range{ count } )
+            {
+                sum += static_cast< std::uint64_t >( ranges[ i ].index_of( probes[ i ] ) );
+            }
+        }
+        return sum;
+    } );
+    run( "index_of: precomputed_step", ops, [&] {
+        auto const ps = roam::precomputed_step< int64_t >{ step };
+        auto sum = std::uint64_t{ 0 };
+        for ( [[maybe_unused]] auto const f : roam::range{ frames } )
+        {
+            for ( auto const i : roam::range{ count } )
+            {
+                sum += static_cast< std::uint64_t >( ps.index_of( ranges[ i ], probes[ i ] ) );
+            }
+        }
+        return sum;
+    } );
+    run( "nested loop: range::size", ops, [&] {
+        auto sum = std::uint64_t{ 0 };
+        for ( [[maybe_unused]] auto const f : roam::range{ frames } )
+        {
+            for ( auto const& r : ranges )
+            {
+                for ( auto const v : r )
+                {
+                    sum += static_cast< std::uint64_t >( v );
+                }
+            }
+        }
+        return sum;
+    } );
+    return 0;
+}
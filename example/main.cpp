@@ -3,6 +3,34 @@
 #include <iostream>
 
 #include "../range.h"
+#include "../range_adaptors.h"
+#include "../range_bitmap.h"
+#include "../range_chrono.h"
+#include "../range_codec.h"
+#include "../range_enum.h"
+#include "../range_fixed.h"
+#include "../range_order.h"
+#include "../range_pairs.h"
+#include "../range_pointer.h"
+#include "../range_random.h"
+#include "../range_set.h"
+#include "../range_stencil.h"
+#include "../range_telemetry.h"
+#include "../range_wavefront.h"
+#include "../range_zip.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 void constexpr_unit_tests()
 {
@@ -44,16 +72,983 @@ void constexpr_unit_tests()
         // float precision makes this tricky, e.g. 6.4
         static_assert( a[ -2 ] == -3.2 + 0.8 * ( sz - 2 ) );
     }
+    {   // floating point size counts exactly the elements operator[] yields before stop
+        // 0.5 + 0.1 * 282 rounds to 28.7 itself, so that element is excluded
+        auto constexpr a = roam::range{ 0.5, 28.7, 0.1 };
+        static_assert( a.size() == 282 && a[ -1 ] < 28.7 );
+        static_assert( roam::range{ 0.0, 0.3, 0.1 }.size() == 3 && roam::range{ 0.0, 1.0, 0.1 }.size() == 10 );
+        static_assert( roam::range{ 1.0, 0.0, -0.1 }.size() == 10 && roam::range{ 1.0, 1.0, 0.1 }.empty() );
+        static_assert( roam::range{ 0.0f, 1.0f, 0.1f }.size() == 10 );
+    }
     {   // enum: implicit init to underlying type
         enum class test_enums { zero, one, two, three, four };
         auto constexpr a = roam::range{ test_enums::four };
         static_assert( a[ 1 ] == 1 );
         static_assert( a[ -2 ] == 2 );
     }
+    {   // typed enum ranges and enum_map
+        enum class test_enums { zero, one, two, three, max };
+        static_assert( roam::enum_count< test_enums > == 4 );
+        auto constexpr a = roam::enum_range< test_enums >{};
+        static_assert( a.size() == 4 && a[ 1 ] == test_enums::one && a[ -1 ] == test_enums::three );
+        auto constexpr b = roam::enum_range{ test_enums::two, test_enums::max };
+        static_assert( b.size() == 2 && b[ 0 ] == test_enums::two && !b.contains( test_enums::one ) );
+        static_assert( roam::enum_cast< test_enums >( 3u ) == test_enums::three );
+        auto constexpr m = roam::enum_map< test_enums, int >{ { test_enums::one, 10 }, { test_enums::three, 30 } };
+        static_assert( m.size() == 4 && m[ test_enums::zero ] == 0 && m[ test_enums::three ] == 30 );
+        static_assert( roam::enum_map< test_enums, int >{ -1 }[ test_enums::two ] == -1 );
+    }
+    {   // fixed point / decimal ranges step exactly
+        using price = roam::decimal< 2 >;
+        static_assert( price{ 0.01 }.raw() == 1 && price{ -101.255 }.raw() == -10126 && price::denominator == 100 );
+        auto constexpr a = roam::range{ price{ 99.50 }, price{ 100.50 }, price{ 0.01 } };
+        static_assert( a.size() == 100 && a[ 50 ] == price{ 100.0 } && a[ -1 ] == price{ 100.49 } );
+        static_assert( a.index_of( price{ 100.00 } ) == 50 && !a.contains( price{ 100.50 } ) );
+        static_assert( a.raw().start() == 9950 && a.slice( 10, 20, 5 ).size() == 2 );
+        static_assert( a.reversed()[ 0 ] == price{ 100.49 } && a.reversed().size() == 100 );
+        // 0.1 steps: the double range needs care with rounding, the decimal one is exact
+        auto constexpr b = roam::range{ roam::decimal< 1 >{ 0.0 }, roam::decimal< 1 >{ 0.3 }, roam::decimal< 1 >{ 0.1 } };
+        static_assert( b.size() == 3 && static_cast< double >( b[ 2 ] ) == 0.2 );
+    }
+    {   // membership and index lookup
+        auto constexpr a = roam::range{ 10, -3, -3 };
+        static_assert( a.contains( 4 ) && !a.contains( 5 ) && !a.contains( -5 ) && a.count( -2 ) == 1 );
+        static_assert( a.index_of( 1 ) == 3 && a.index_of( 11 ) == -1 );
+        static_assert( roam::range< uint8_t >{ 200, 255, 5 }.index_of( 250 ) == 10 );
+        static_assert( roam::range< int64_t >{ INT64_MIN, INT64_MAX, INT64_MAX }.index_of( -1 ) == 1 );
+        auto constexpr d = roam::range{ -3.2, 8.0, 0.8 };
+        static_assert( d.index_of( 6.4 ) == 12 && d.contains( -1.6 ) && !d.contains( -1.5 ) && !d.contains( 8.0 ) );
+    }
+    {   // intersection of progressions
+        auto constexpr a = roam::intersect( roam::range{ 0, 100, 6 }, roam::range{ 4, 100, 10 } );
+        static_assert( a.size() == 3 && a[ 0 ] == 24 && a[ -1 ] == 84 && a.step() == 30 );
+        auto constexpr b = roam::intersect( roam::range{ 99, 0, -3 }, roam::range{ 1, 50, 4 } );
+        static_assert( b[ 0 ] == 45 && b[ -1 ] == 9 && b.step() == -12 );
+        static_assert( roam::intersect( roam::range{ 0, 100, 2 }, roam::range{ 1, 100, 2 } ).empty() );
+        // an lcm past the type's limits, a single common value
+        auto constexpr c = roam::intersect( roam::range< int >{ 0, 2000000000, 65537 }, roam::range< int >{ 0, 2000000000, 65539 } );
+        static_assert( c.size() == 1 && c[ 0 ] == 0 );
+        // values past INTMAX_MAX
+        auto constexpr d = roam::intersect( roam::range< unsigned long long >{ 0, ~0ull, 1ull << 62 }, roam::range< unsigned long long >{ 0, ~0ull, 3ull << 61 } );
+        static_assert( d.size() == 2 && d[ 0 ] == 0 && d[ -1 ] == 3ull << 62 && d.step() == 3ull << 62 );
+        auto constexpr e = roam::intersect( roam::range< int64_t >{ INT64_MAX, INT64_MIN, -( INT64_MAX / 3 ) }, roam::range< int64_t >{ INT64_MIN + 3, INT64_MAX, INT64_MAX / 3 } );
+        static_assert( e.size() == 6 && e[ 0 ] == INT64_MAX - INT64_MAX / 3 && e[ -1 ] == INT64_MIN + 3 && e.step() == -( INT64_MAX / 3 ) );
+        // two common values 200 apart, an int8_t step cannot hold it
+        auto constexpr f = roam::intersect( roam::range< int8_t, roam::checking::saturating >{ -100, 127, 8 }, roam::range< int8_t, roam::checking::saturating >{ -100, 127, 25 } );
+        static_assert( f.size() == 1 && f[ 0 ] == -100 );
+    }
+    {   // python slicing and reversal
+        auto constexpr a = roam::range{ 0, 100, 3 }.slice( 5, 20, 2 );
+        static_assert( a.start() == 15 && a.stop() == 60 && a.step() == 6 && a.size() == 8 );
+        static_assert( roam::range{ 10 }.slice( -3, 100 ).start() == 7 && roam::range{ 10 }.slice( -3, 100 ).size() == 3 );
+        auto constexpr b = roam::range{ 10 }.slice( 8, 2, -2 );
+        static_assert( b.size() == 3 && b[ 0 ] == 8 && b[ -1 ] == 4 );
+        static_assert( roam::range{ 10 }.slice( -1, -11, -1 ).size() == 10 && roam::range{ 10 }.slice( 5, 2 ).empty() );
+        static_assert( roam::range< uint32_t >{ 4, 40, 4 }.slice( 1, -1, 3 ).size() == 3 );
+        auto constexpr c = roam::range{ 0, 10, 3 }.reversed();
+        static_assert( c.size() == 4 && c[ 0 ] == 9 && c[ -1 ] == 0 && c.step() == -3 );
+        static_assert( roam::range{ 4, 4 }.reversed().empty() );
+        static_assert( roam::range< int8_t >{ -128, 127, 100 }.slice( 0, 3 ).size() == 3 && roam::range< int8_t >{ -128, 127, 100 }.slice( 0, 3 )[ -1 ] == 72 );
+        static_assert( roam::range< int8_t >{ -128, 127, 127 }.slice( 1, 3, 5 ).size() == 1 && roam::range< int8_t >{ -128, 127, 127 }.slice( 1, 3, 5 )[ 0 ] == -1 );
+        auto constexpr h = roam::range< int8_t >{ -127, 0, 50 }.slice( -1, -4, -1 );
+        static_assert( h.size() == 3 && h[ 0 ] == -27 && h[ -1 ] == -127 && h.stop() == -128 );
+        auto constexpr m = roam::range< int8_t >{ -128, -123 }.slice( -1, -6, -3 );
+        static_assert( m.size() == 2 && m[ 0 ] == -124 && m[ 1 ] == -127 && m.stop() == -128 );
+        auto constexpr w = roam::range< int >{ INT_MIN, INT_MAX, 1 << 30 }.slice( 1, 100 );
+        static_assert( w.size() == 3 && w[ 0 ] == -( 1 << 30 ) && w[ -1 ] == 1 << 30 && w.stop() == INT_MAX );
+        auto constexpr d = roam::range< int8_t >{ -127, 0 }.reversed();
+        static_assert( d.size() == 127 && d[ 0 ] == -1 && d[ -1 ] == -127 && d.stop() == -128 );
+        auto constexpr e = roam::range< int >{ INT_MIN + 1, 0, 2 }.reversed();
+        static_assert( e.size() == roam::range< int >{ INT_MIN + 1, 0, 2 }.size() && e[ -1 ] == INT_MIN + 1 && e.stop() == INT_MIN );
+        auto constexpr f = roam::range< int8_t >{ 126, 0, -100 }.reversed();
+        static_assert( f.size() == 2 && f[ 0 ] == 26 && f[ 1 ] == 126 && f.stop() == 127 );
+        auto constexpr g = roam::range< int8_t, roam::checking::saturating >{ -128, 0 }.reversed();
+        static_assert( g.size() == 127 && g[ 0 ] == -1 && g[ -1 ] == -127 );
+    }
+    {   // checking policies
+        static_assert( roam::gsl::is_value_preserving_v< int64_t, int32_t > && roam::gsl::is_value_preserving_v< int32_t, uint16_t > );
+        static_assert( roam::gsl::is_value_preserving_v< double, int32_t > && !roam::gsl::is_value_preserving_v< float, int32_t > );
+        static_assert( !roam::gsl::is_value_preserving_v< uint64_t, int8_t > && !roam::gsl::is_value_preserving_v< int32_t, uint32_t > );
+        static_assert( roam::gsl::narrow< uint8_t, roam::checking::saturating >( 300 ) == 255 );
+        static_assert( roam::gsl::narrow< uint8_t, roam::checking::saturating >( -5 ) == 0 );
+        static_assert( roam::gsl::narrow< int8_t, roam::checking::saturating >( -1000 ) == -128 );
+        static_assert( roam::gsl::narrow< int32_t, roam::checking::saturating >( 1e30 ) == INT32_MAX );
+        static_assert( roam::gsl::narrow< int32_t, roam::checking::saturating >( UINT64_MAX ) == INT32_MAX );
+        using saturating = roam::range< int, roam::checking::saturating >;
+        static_assert( saturating{ 5, 0 }.empty() && saturating{ 5, 9, 0 }.empty() );
+        static_assert( saturating{ 0, 10, 3 }[ 100 ] == 9 && saturating{ 0, 10, 3 }[ -100 ] == 0 );
+        static_assert( roam::range< int, roam::checking::unchecked >{ 0, 10, 2 }[ 3 ] == 6 );
+        static_assert( roam::range< int, roam::checking::validated >{ roam::range{ 4, 0, -1 } }[ -1 ] == 1 );
+    }
+    {   // time points with a duration step
+        using namespace std::chrono_literals;
+        using time_point = std::chrono::time_point< std::chrono::system_clock, std::chrono::nanoseconds >;
+        auto constexpr t0 = time_point{ 1'700'000'000s };
+        auto constexpr a = roam::time_range{ t0, t0 + 1min, 10s };
+        static_assert( a.size() == 6 && a[ 2 ] == t0 + 20s && a[ -1 ] == t0 + 50s );
+        static_assert( a.bucket_of( t0 + 25s ) == 2 && a.bucket_of( t0 + 59999ms ) == 5 );
+        static_assert( a.bucket_of( t0 - 1ns ) == -1 && a.bucket_of( t0 + 1min ) == -1 );
+        static_assert( a.index_of( t0 + 30s ) == 3 && !a.contains( t0 + 31s ) );
+    }
+    {   // division free size and membership for a reused step
+        static_assert( roam::range< uint64_t >{ 0, UINT64_MAX, 3 }.size() == 6148914691236517205u );
+        static_assert( roam::range< int8_t >{ -128, 127, 1 }.size() == 255 );
+        auto constexpr s7 = roam::precomputed_step{ 7 };
+        static_assert( s7.size( roam::range{ 0, 100, 7 } ) == 15 && s7.size( roam::range{ 3, 3, 7 } ) == 0 );
+        static_assert( s7.index_of( roam::range{ 2, 100, 7 }, 30 ) == 4 && s7.index_of( roam::range{ 2, 100, 7 }, 31 ) == -1 );
+        static_assert( roam::precomputed_step{ -4 }.size( roam::range{ 10, -3, -4 } ) == 4 );
+        static_assert( roam::precomputed_step< uint64_t >{ UINT64_MAX }.divide( UINT64_MAX ) == 1 );
+    }
+    {   // keyed permutation visits every element once
+        auto constexpr a = roam::shuffled( roam::range{ 10, 47 }, 3 );
+        static_assert( a.size() == 37 );
+        static_assert( [&] {
+            bool seen[ 37 ]{};
+            for ( auto i = 0; i < 37; ++i ) {
+                seen[ a[ i ] - 10 ] = true;
+            }
+            for ( auto const b : seen ) {
+                if ( !b ) {
+                    return false;
+                }
+            }
+            return a[ -1 ] == a[ 36 ];
+        }() );
+    }
+    {   // all pairs i < j
+        auto constexpr a = roam::pairs( 5 );
+        static_assert( a.size() == 10 );
+        static_assert( a[ 0 ] == std::pair{ 0, 1 } );
+        static_assert( a[ 3 ] == std::pair{ 0, 3 } );
+        static_assert( a[ -1 ] == std::pair{ 3, 4 } );
+        static_assert( a.index_of( 2, 3 ) == 5 );
+        static_assert( a.split( 1, 3 ).size() == 3 );
+        static_assert( a.split( 1, 3 )[ 0 ] == a[ 4 ] );
+    }
+    {   // lower triangle including diagonal
+        auto constexpr a = roam::lower_triangle( 4 );
+        static_assert( a.size() == 10 );
+        static_assert( a[ 2 ] == std::pair{ 1, 1 } );
+        static_assert( a.index_of( 3, 2 ) == 8 );
+    }
+    {   // anti-diagonals of a 3 x 4 grid
+        auto constexpr a = roam::wavefront{ roam::ndrange{ roam::range{ 3 }, roam::range{ 10, 14 } } };
+        static_assert( a.size() == 6 );
+        static_assert( a[ 2 ].size() == 3 );
+        static_assert( a[ 4 ][ 0 ][ 0 ] == 1 && a[ 4 ][ 0 ][ 1 ] == 13 );
+        static_assert( a[ -1 ][ 0 ][ 0 ] == 2 && a[ -1 ][ 0 ][ 1 ] == 13 );
+    }
+    {   // random access adaptors keep size and operator[]
+        auto constexpr a = roam::range{ 20 } | roam::transform( []( int const i ) { return i * i; } )
+                                             | roam::stride( 3 ) | roam::drop( 1 ) | roam::take( 4 ) | roam::reverse();
+        static_assert( a.size() == 4 );
+        static_assert( a[ 0 ] == 144 && a[ 1 ] == 81 && a[ -1 ] == 9 );
+        static_assert( ( roam::range{ 10 } | roam::stride( 4 ) ).size() == 3 );
+        static_assert( ( roam::range{ 10 } | roam::drop( 20 ) ).empty() );
+    }
+}
+
+void runtime_unit_tests()
+{
+    {   // pairs: iteration, random access and tiles agree
+        auto const a = roam::pairs( 37 );
+        auto k = std::ptrdiff_t{ 0 };
+        for ( auto const [ i, j ] : a )
+        {
+            assert( i < j && a[ k ] == std::pair( i, j ) && a.index_of( i, j ) == k );
+            ++k;
+        }
+        assert( k == static_cast< std::ptrdiff_t >( a.size() ) );
+        auto tiled = std::size_t{ 0 };
+        for ( auto const& t : a.tiles( 8 ) )
+        {
+            t.for_each( [&]( int const i, int const j ) { assert( i < j ); ++tiled; } );
+        }
+        assert( tiled == a.size() );
+    }
+    {   // wavefront: parallel edit distance matches the serial table
+        auto const x = std::string{ "intention" };
+        auto const y = std::string{ "execution" };
+        auto const grid = roam::ndrange{ roam::range{ x.size() + 1 }, roam::range{ y.size() + 1 } };
+        auto const cols = y.size() + 1;
+        auto const kernel = [&]( std::vector< std::size_t >& t, std::size_t const i, std::size_t const j ) {
+            auto& cell = t[ i * cols + j ];
+            if ( i == 0 || j == 0 )
+            {
+                cell = i + j;
+                return;
+            }
+            auto const sub = t[ ( i - 1 ) * cols + j - 1 ] + ( x[ i - 1 ] == y[ j - 1 ] ? 0 : 1 );
+            cell = std::min( { sub, t[ ( i - 1 ) * cols + j ] + 1, t[ i * cols + j - 1 ] + 1 } );
+        };
+        auto serial = std::vector< std::size_t >( grid.size() );
+        for ( auto const [ i, j ] : grid )
+        {
+            kernel( serial, i, j );
+        }
+        auto cells = std::vector< std::size_t >( grid.size() );
+        roam::parallel_wavefront( roam::wavefront{ grid }, 4, [&]( auto const& c ) { kernel( cells, c[ 0 ], c[ 1 ] ); } );
+        assert( cells == serial && serial.back() == 5 );
+        auto tiles = std::vector< std::size_t >( grid.size() );
+        roam::parallel_wavefront( roam::blocked_wavefront{ grid, 3, 4 }, 3, [&]( auto const& tile ) {
+            for ( auto const [ i, j ] : tile )
+            {
+                kernel( tiles, i, j );
+            }
+        } );
+        assert( tiles == serial );
+    }
+    {   // stencil regions: interior plus slabs cover the domain exactly once
+        auto const grid = roam::ndrange{ roam::range{ 6 }, roam::range{ 0, 14, 2 } };
+        auto const regions = roam::stencil_regions( grid, 1 );
+        assert( regions.interior.size() == 4 * 5 );
+        auto covered = std::vector< int >( grid.size() );
+        auto const visit = [&]( auto const& p ) { ++covered[ p[ 0 ] * 7 + p[ 1 ] / 2 ]; };
+        for ( auto const& p : regions.interior )
+        {
+            assert( p[ 0 ] >= 1 && p[ 0 ] <= 4 && p[ 1 ] >= 2 && p[ 1 ] <= 10 );
+            visit( p );
+        }
+        for ( auto const& slab : regions.boundary )
+        {
+            for ( auto const& p : slab )
+            {
+                visit( p );
+            }
+        }
+        assert( std::count( covered.begin(), covered.end(), 1 ) == static_cast< std::ptrdiff_t >( grid.size() ) );
+    }
+    {   // enumerate / zip: references into the containers, index from the range
+        auto va = std::vector< int >{ 1, 2, 3, 4, 5 };
+        int const vb[] = { 10, 20, 30, 40, 50, 60 };
+        for ( auto const [ i, a ] : roam::enumerate( va ) )
+        {
+            a *= 2;
+            assert( va[ i ] == static_cast< int >( 2 * ( i + 1 ) ) );
+        }
+        auto sum = 0;
+        for ( auto const [ i, a, b ] : roam::zip( roam::range{ 4, -1, -2 }, va, vb ) )
+        {
+            sum += a + b;
+        }
+        assert( sum == ( 10 + 6 + 2 ) + ( 50 + 30 + 10 ) );
+        auto const wide = std::vector< int >( 128, 1 );
+        auto edge = 0;
+        for ( auto const [ i, w ] : roam::zip( roam::range< int8_t >{ 120, 127, 3 }, wide ) )
+        {   // ends within one step of INT8_MAX
+            edge += i * w;
+        }
+        assert( edge == 120 + 123 + 126 );
+        assert( !roam::covers( va, roam::range{ 0, 6 } ) && roam::covers( vb, roam::range{ 0, 6 } ) );
+        auto reported = false;
+        try
+        {
+            static_cast< void >( roam::zip( roam::range< int, roam::checking::throwing >{ 0, 6 }, vb, va ) );
+        }
+        catch ( roam::out_of_range_error const& )
+        {
+            reported = true;
+        }
+        assert( reported );
+    }
+    {   // filter: forward iteration over matches
+        auto found = std::vector< int >{};
+        for ( auto const v : roam::range{ 1, 30, 2 } | roam::take( 11 ) | roam::filter( []( int const i ) { return i % 3 == 0; } ) )
+        {
+            found.push_back( v );
+        }
+        for ( auto const v : roam::range{ 1, 30, 2 } | roam::reverse() | roam::filter( []( int const i ) { return i % 7 == 0; } ) )
+        {
+            found.push_back( v );
+        }
+        assert( ( found == std::vector< int >{ 3, 9, 15, 21, 21, 7 } ) );
+    }
+    {   // intersect agrees with brute force
+        auto rng = std::mt19937{ 11 };
+        auto pick = std::uniform_int_distribution< int >{ -40, 40 };
+        auto const random_range = [&] {
+            auto step = 0;
+            while ( step == 0 )
+            {
+                step = pick( rng ) / 4;
+            }
+            auto const start = pick( rng );
+            auto const stop = start + step * ( pick( rng ) + 40 ) / 4;
+            return roam::range{ start, stop, step };
+        };
+        for ( [[maybe_unused]] auto const _ : roam::range{ 2000 } )
+        {
+            auto const a = random_range();
+            auto const b = random_range();
+            auto expect = std::vector< int >{};
+            for ( auto const v : a )
+            {
+                if ( b.contains( v ) )
+                {
+                    expect.push_back( v );
+                }
+            }
+            auto const c = roam::intersect( a, b );
+            assert( std::equal( c.begin(), c.end(), expect.begin(), expect.end() ) );
+        }
+        auto reported = false;
+        try
+        {
+            using range_t = roam::range< int8_t, roam::checking::throwing >;
+            static_cast< void >( roam::intersect( range_t{ -100, 127, 8 }, range_t{ -100, 127, 25 } ) );
+        }
+        catch ( roam::invalid_range_error const& )
+        {
+            reported = true;
+        }
+        assert( reported );
+    }
+    {   // slice / reversed agree with indexing, reverse iteration agrees with reversed
+        auto const r = roam::range{ -7, 50, 4 };
+        auto const n = static_cast< int >( r.size() );
+        for ( auto const start : roam::range{ -n - 2, n + 2 } )
+        {
+            for ( auto const stop : roam::range{ -n - 2, n + 2 } )
+            {
+                for ( auto const step : { -3, -1, 1, 2 } )
+                {
+                    auto expect = std::vector< int >{};
+                    auto const lo = step > 0 ? 0 : -1;
+                    auto const hi = step > 0 ? n : n - 1;
+                    auto const clamp = [&]( int i ) { i = i < 0 ? i + n : i; return i < lo ? lo : i > hi ? hi : i; };
+                    for ( auto i = clamp( start ); step > 0 ? i < clamp( stop ) : i > clamp( stop ); i += step )
+                    {
+                        expect.push_back( r[ i ] );
+                    }
+                    auto const s = r.slice( start, stop, step );
+                    assert( std::equal( s.begin(), s.end(), expect.begin(), expect.end() ) );
+                }
+            }
+        }
+        auto const rev = r.reversed();
+        assert( std::equal( r.rbegin(), r.rend(), rev.begin(), rev.end() ) );
+        assert( std::equal( rev.rbegin(), rev.rend(), r.begin(), r.end() ) );
+    }
+    {   // throwing and validated policies report errors as exceptions
+        auto const throws = []( auto&& fn ) {
+            try
+            {
+                fn();
+            }
+            catch ( std::exception const& )
+            {
+                return true;
+            }
+            return false;
+        };
+        using throwing = roam::range< int, roam::checking::throwing >;
+        using validated = roam::range< int64_t, roam::checking::validated >;
+        assert( throws( [] { return throwing{ 0, 10, -1 }.size(); } ) );
+        assert( throws( [] { return throwing{ 0, 10, 0 }.size(); } ) );
+        assert( throws( [] { return throwing{ 0, 10, 3 }[ 4 ]; } ) );
+        assert( !throws( [] { return throwing{ 0, 10, 3 }[ -4 ]; } ) );
+        assert( throws( [] { return roam::gsl::narrow< uint8_t, roam::checking::throwing >( 256 ); } ) );
+        auto const throws_as = []( auto&& fn, auto const error ) {
+            try
+            {
+                fn();
+            }
+            catch ( decltype( error ) const& )
+            {
+                return true;
+            }
+            catch ( ... )
+            {
+            }
+            return false;
+        };
+        assert( throws_as( [] { return throwing{ 0, 10, 0 }.size(); }, roam::invalid_range_error{ "" } ) );
+        assert( throws_as( [] { return throwing{ 0, 10, 3 }[ 4 ]; }, roam::out_of_range_error{ "" } ) );
+        assert( throws_as( [] { return throwing{ 0, 10, 3 }[ 4 ]; }, roam::range_error{ "" } ) );
+        assert( throws_as( [] { return throwing{ 0, 10, 3 }[ 4 ]; }, std::out_of_range{ "" } ) );
+        assert( throws_as( [] { return throwing{ 0, 10, 0 }.size(); }, std::invalid_argument{ "" } ) );
+        assert( throws_as( [] { return roam::range< uint64_t, roam::checking::validated >{ 0, UINT64_MAX }.size(); }, std::length_error{ "" } ) );
+        assert( throws_as( [] { return roam::range< int8_t, roam::checking::throwing >{ -128, 0 }.reversed(); }, roam::invalid_range_error{ "" } ) );
+        assert( throws_as( [] { return throwing{ INT_MIN, 0 }.reversed(); }, roam::invalid_range_error{ "" } ) );
+        assert( throws_as( [] { return roam::range< int8_t, roam::checking::throwing >{ 127, -128, -128 }.reversed(); }, roam::invalid_range_error{ "" } ) );
+        assert( throws_as( [] { return roam::range< int8_t, roam::checking::throwing >{ -128, 127, 127 }.slice( 0, 3, 2 ); }, roam::invalid_range_error{ "" } ) );
+        assert( throws_as( [] { return roam::range< double, roam::checking::throwing >{ 0.0, std::numeric_limits< double >::infinity() }.size(); }, roam::range_length_error{ "" } ) );
+        assert( throws_as( [] { return roam::range< double, roam::checking::validated >{ 0.0, 1e300, 1e-300 }; }, std::length_error{ "" } ) );
+        assert( ( roam::range< double, roam::checking::saturating >{ 0.0, std::numeric_limits< double >::infinity() }.size() == static_cast< std::size_t >( PTRDIFF_MAX ) ) );
+        assert( ( roam::range< float, roam::checking::unchecked >{ 0.0f, 1e30f, 1e-30f }.size() == static_cast< std::size_t >( PTRDIFF_MAX ) ) );
+        assert( throws( [] { return validated{ 10, 0 }.size(); } ) );
+        assert( throws( [] { return roam::range< uint64_t, roam::checking::validated >{ 0, UINT64_MAX }.size(); } ) );
+        auto const v = validated{ roam::range< int64_t >{ -5, 40, 7 } };
+        auto sum = int64_t{ 0 };
+        for ( auto const i : v )
+        {
+            sum += i;
+        }
+        assert( sum == 112 && v.slice( 1, -1 ).size() == 5 );
+    }
+    {   // batch bucketing agrees with per timestamp bucketing and floor division
+        using time_point = std::chrono::time_point< std::chrono::system_clock, std::chrono::nanoseconds >;
+        auto rng = std::mt19937_64{ 5 };
+        for ( auto const step_ns : { int64_t{ 1 }, int64_t{ 7 }, int64_t{ 10'000'000'000 }, int64_t{ 999'999'937 } } )
+        {
+            auto const t0 = time_point{ std::chrono::nanoseconds{ 1'700'000'000'000'000'000 } };
+            auto const buckets = roam::time_range{ t0, t0 + std::chrono::hours{ 24 }, std::chrono::nanoseconds{ step_ns } };
+            auto const span = ( buckets.stop() - buckets.start() ).count();
+            auto stamps = std::vector< time_point >{};
+            for ( [[maybe_unused]] auto const _ : roam::range{ 1000 } )
+            {
+                auto const offset = static_cast< int64_t >( rng() % static_cast< uint64_t >( span + span / 4 ) ) - span / 8;
+                stamps.push_back( t0 + std::chrono::nanoseconds{ offset } );
+            }
+            stamps.push_back( time_point{ std::chrono::nanoseconds{ INT64_MIN } } );
+            stamps.push_back( time_point{ std::chrono::nanoseconds{ INT64_MAX } } );
+            auto ids = std::vector< std::ptrdiff_t >( stamps.size() );
+            buckets.bucket_of( stamps, ids );
+            for ( auto const i : roam::range{ stamps.size() } )
+            {
+                auto const inside = t0 <= stamps[ i ] && stamps[ i ] < buckets.stop();
+                auto const expect = inside ? static_cast< std::ptrdiff_t >( ( stamps[ i ] - t0 ).count() / step_ns ) : -1;
+                assert( ids[ i ] == expect && buckets.bucket_of( stamps[ i ] ) == expect );
+            }
+        }
+        // ranges at and across the ends of time_point, the widest take the exact path
+        auto const lo = time_point::min();
+        auto const hi = time_point::max();
+        auto const stamps = std::vector< time_point >{ lo, lo + std::chrono::nanoseconds{ 1 }, time_point{}, hi - std::chrono::nanoseconds{ 1 }, hi };
+        auto const check = [&]( roam::time_range< std::chrono::system_clock, std::chrono::nanoseconds > const& buckets ) {
+            auto ids = std::vector< std::ptrdiff_t >( stamps.size() );
+            buckets.bucket_of( stamps, ids );
+            for ( auto const i : roam::range{ stamps.size() } )
+            {
+                assert( ids[ i ] == buckets.bucket_of( stamps[ i ] ) );
+            }
+            return ids;
+        };
+        auto const all = check( roam::time_range{ lo, hi, std::chrono::nanoseconds{ INT64_MAX / 4 } } );
+        assert( ( all == std::vector< std::ptrdiff_t >{ 0, 0, 4, 8, -1 } ) );
+        auto const top = check( roam::time_range{ hi - std::chrono::nanoseconds{ 10 }, hi, std::chrono::nanoseconds{ 3 } } );
+        assert( ( top == std::vector< std::ptrdiff_t >{ -1, -1, -1, 3, -1 } ) );
+        auto const bottom = check( roam::time_range{ lo, lo + std::chrono::nanoseconds{ 10 }, std::chrono::nanoseconds{ 3 } } );
+        assert( ( bottom == std::vector< std::ptrdiff_t >{ 0, 0, -1, -1, -1 } ) );
+    }
+    {   // pointer ranges with element and byte strides, iterator ranges
+        float xs[ 10 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        auto const evens = roam::range{ xs, xs + 10, 2 };
+        assert( evens.size() == 5 && evens[ -1 ] == 8.0f && !evens.contiguous() );
+        for ( auto& x : evens )
+        {
+            x = -x;
+        }
+        assert( xs[ 2 ] == -2.0f && xs[ 3 ] == 3.0f && ( roam::range{ xs, xs + 9, 3 }.size() == 3 ) );
+        auto const all = roam::range{ xs, xs + 10 };
+        assert( all.contiguous() && all.data() == xs && all.size() == 10 );
+
+        struct vertex
+        {
+            float pos[ 3 ];
+            int id;
+        };
+        auto verts = std::vector< vertex >{};
+        for ( auto const i : roam::range{ 6 } )
+        {
+            verts.push_back( vertex{ { 0.0f, 0.0f, 0.0f }, i * 10 } );
+        }
+        auto const ids = roam::range{ &verts[ 0 ].id, verts.size(), roam::byte_stride{ sizeof( vertex ) } };
+        assert( ids.size() == 6 && ids[ 3 ] == 30 && ids.stride() == sizeof( vertex ) );
+        auto packed = std::vector< int >( ids.size() );
+        ids.copy_to( packed.data() );
+        assert( ( packed == std::vector< int >{ 0, 10, 20, 30, 40, 50 } ) );
+        ids[ -1 ] = 7;
+        assert( verts[ 5 ].id == 7 );
+        auto const backwards = roam::range{ &verts[ 5 ].id, 3, roam::byte_stride{ -static_cast< std::ptrdiff_t >( sizeof( vertex ) ) } };
+        assert( backwards[ 0 ] == 7 && backwards[ 2 ] == 30 );
+
+        auto dq = std::deque< int >{ 0, 1, 2, 3, 4, 5, 6 };
+        auto const thirds = roam::strided( dq.begin(), dq.end(), 3 );
+        assert( thirds.size() == 3 && thirds[ 2 ] == 6 && !thirds.contiguous() );
+        for ( auto& v : thirds )
+        {
+            v += 100;
+        }
+        assert( dq[ 3 ] == 103 && dq[ 4 ] == 4 );
+        auto const down = roam::strided( dq.end() - 1, dq.begin(), -2 );
+        assert( down.size() == 3 && down[ 0 ] == 106 && down[ -1 ] == 2 );
+
+        // invalid steps are reported through the policy, saturating ranges are empty
+        using throwing_floats = roam::range< float*, roam::checking::throwing >;
+        using throwing_strided = roam::iterator_range< std::deque< int >::iterator, roam::checking::throwing >;
+        auto const rejects = [&]( auto&& fn ) {
+            try
+            {
+                static_cast< void >( fn() );
+            }
+            catch ( roam::invalid_range_error const& )
+            {
+                return true;
+            }
+            return false;
+        };
+        assert( rejects( [&] { return throwing_floats{ xs, xs + 10, 0 }; } ) && rejects( [&] { return throwing_floats{ xs + 10, xs, 2 }; } ) );
+        assert( rejects( [&] { return throwing_strided{ dq.begin(), dq.end(), 0 }; } ) && rejects( [&] { return throwing_strided{ dq.begin(), dq.end(), -1 }; } ) );
+        assert( !rejects( [&] { return throwing_floats{ xs + 10, xs, -2 }; } ) );
+        assert( ( roam::range< float*, roam::checking::saturating >{ xs + 10, xs, 2 }.empty() ) );
+        assert( ( roam::iterator_range< std::deque< int >::iterator, roam::checking::saturating >{ dq.begin(), dq.end(), 0 }.empty() ) );
+    }
+    {   // enum_range yields the enum type, enum_map is indexed by it
+        enum class stage : uint8_t { parse, plan, run, count };
+        auto names = roam::enum_map< stage, std::string >{ { stage::parse, "parse" }, { stage::plan, "plan" }, { stage::run, "run" } };
+        auto joined = std::string{};
+        for ( auto const s : roam::enum_range< stage >{} )
+        {
+            static_assert( std::is_same_v< decltype( s ), stage const > );
+            joined += names[ s ];
+        }
+        assert( joined == "parseplanrun" );
+        auto hits = roam::enum_map< stage, int >{};
+        for ( auto const s : { stage::run, stage::parse, stage::run } )
+        {
+            ++hits[ s ];
+        }
+        assert( hits[ stage::parse ] == 1 && hits[ stage::plan ] == 0 && hits[ stage::run ] == 2 );
+        auto const keys = hits.keys();
+        assert( keys.size() == hits.size() && keys[ 2 ] == stage::run && hits.values()[ 2 ] == 2 );
+    }
+    {   // decimal price ladder, iteration yields the fixed point type
+        using price = roam::decimal< 4 >;
+        auto const ladder = roam::range{ price{ 1.0 }, price{ 1.01 }, price{ 0.0001 } };
+        auto n = 0;
+        auto last = price{};
+        for ( auto const p : ladder )
+        {
+            static_assert( std::is_same_v< decltype( p ), price const > );
+            assert( n == 0 || p - last == ladder.step() );
+            last = p;
+            ++n;
+        }
+        assert( n == 100 && last == price{ 1.0099 } );
+        auto const down = roam::range< price >{ roam::range< int64_t >{ 10100, 10000, -25 } };
+        assert( down.size() == 4 && static_cast< double >( down[ -1 ] ) == 1.0025 );
+    }
+    {   // floating point size: last element before stop, the next one is not, for any rounding
+        auto rng = std::mt19937_64{ 45 };
+        auto tenths = std::uniform_int_distribution< int >{ -10000, 10000 };
+        for ( [[maybe_unused]] auto const _ : roam::range{ 20000 } )
+        {
+            auto const start = tenths( rng ) / 10.0;
+            auto const step = ( 1 + tenths( rng ) % 100 + 100 ) / 100.0 * ( tenths( rng ) < 0 ? -1.0 : 1.0 );
+            auto const stop = start + step * ( tenths( rng ) + 10000 ) / 77.0;
+            auto const r = roam::range{ start, stop, step };
+            auto const n = static_cast< std::ptrdiff_t >( r.size() );
+            auto const at = [&]( std::ptrdiff_t const i ) { return start + step * static_cast< double >( i ); };
+            assert( n == 0 || ( step > 0 ? r[ n - 1 ] < stop : r[ n - 1 ] > stop ) );
+            assert( step > 0 ? at( n ) >= stop : at( n ) <= stop );
+        }
+    }
+    {   // iterators carry the value, forward and reverse across the full type range
+        auto vals = std::vector< int64_t >{};
+        auto const wide = roam::range< int64_t >{ INT64_MIN, INT64_MAX, INT64_MAX };
+        for ( auto const v : wide )
+        {
+            vals.push_back( v );
+        }
+        for ( auto it = wide.rbegin(); it != wide.rend(); ++it )
+        {
+            vals.push_back( *it );
+        }
+        assert( ( vals == std::vector< int64_t >{ INT64_MIN, -1, INT64_MAX - 1, INT64_MAX - 1, -1, INT64_MIN } ) );
+        auto bytes = std::vector< int >{};
+        for ( auto const v : roam::range< int8_t >{ -128, 127, 100 } )
+        {
+            bytes.push_back( v );
+        }
+        auto const down = roam::range< uint8_t >{ 0, 255, 51 };
+        for ( auto it = down.rbegin(); it != down.rend(); ++it )
+        {
+            bytes.push_back( *it );
+        }
+        assert( ( bytes == std::vector< int >{ -128, -28, 72, 204, 153, 102, 51, 0 } ) );
+    }
+    {   // 32 bit iterators stepping past the end at the type's limits don't overflow
+        auto vals = std::vector< int >{};
+        for ( auto const v : roam::range< int >{ INT_MAX - 7, INT_MAX, 3 } )
+        {
+            vals.push_back( v );
+        }
+        for ( auto const v : roam::range< int >{ INT_MIN + 7, INT_MIN, -3 } )
+        {
+            vals.push_back( v );
+        }
+        auto const low = roam::range< int >{ INT_MIN, INT_MIN + 2 };
+        for ( auto it = low.rbegin(); it != low.rend(); ++it )
+        {
+            vals.push_back( *it );
+        }
+        for ( auto const v : roam::range< int >{ INT_MAX - 1, INT_MAX } )
+        {
+            vals.push_back( v );
+        }
+        assert( ( vals == std::vector< int >{ INT_MAX - 7, INT_MAX - 4, INT_MAX - 1, INT_MIN + 7, INT_MIN + 4, INT_MIN + 1,
+                                              INT_MIN + 1, INT_MIN, INT_MAX - 1 } ) );
+        auto const wide = roam::range< int >{ 0, INT_MAX, INT_MAX / 2 };
+        auto it = wide.begin();
+        ++it;
+        ++it;
+        assert( *it == INT_MAX - 1 && ++it == wide.end() );
+        --it;
+        assert( *it == INT_MAX - 1 );
+    }
+    {   // precomputed_step agrees with range::size / index_of
+        auto rng = std::mt19937_64{ 3 };
+        for ( [[maybe_unused]] auto const _ : roam::range{ 20000 } )
+        {
+            auto const step = static_cast< int64_t >( rng() >> ( rng() % 64 ) ) * ( rng() % 2 == 0 ? 1 : -1 );
+            if ( step == 0 || step == INT64_MIN )
+            {
+                continue;
+            }
+            auto const start = static_cast< int64_t >( rng() >> 2 ) - ( INT64_MAX >> 2 );
+            auto const span = static_cast< int64_t >( rng() >> ( 2 + rng() % 62 ) );
+            auto const r = roam::range< int64_t >{ start, step > 0 ? start + span : start - span, step };
+            auto const ps = roam::precomputed_step{ step };
+            assert( ps.size( r ) == r.size() );
+            auto const v = r.empty() ? start : r[ static_cast< std::ptrdiff_t >( rng() % r.size() ) ];
+            assert( ps.index_of( r, v ) == r.index_of( v ) && ps.index_of( r, v + 1 ) == r.index_of( v + 1 ) );
+        }
+    }
+    {   // shuffled: permutation for every small size, seeds give different orders
+        for ( auto const n : roam::range{ 0, 300 } )
+        {
+            auto const a = roam::shuffled( roam::range{ 0, 2 * n, 2 }, static_cast< uint64_t >( n ) );
+            auto seen = std::vector< int >( static_cast< std::size_t >( n ) );
+            for ( auto const v : a )
+            {
+                ++seen[ static_cast< std::size_t >( v / 2 ) ];
+            }
+            assert( std::all_of( seen.begin(), seen.end(), []( int const c ) { return c == 1; } ) );
+        }
+        auto const a = roam::shuffled( roam::range{ 1000 }, 1 );
+        auto const b = roam::shuffled( roam::range{ 1000 }, 2 );
+        assert( !std::equal( a.begin(), a.end(), b.begin(), b.end() ) );
+        auto in_place = 0;
+        for ( auto const i : roam::range{ 1000 } )
+        {
+            in_place += a[ i ] == i ? 1 : 0;
+        }
+        assert( in_place < 20 );
+        // index spaces far too large to materialize, random access stays cheap
+        auto const big = roam::shuffled( roam::range< int64_t >{ 10'000'000'000 }, 7 );
+        auto distinct = std::set< int64_t >{};
+        for ( auto const i : roam::range{ 1000 } )
+        {
+            auto const v = big[ i ];
+            assert( 0 <= v && v < 10'000'000'000 );
+            distinct.insert( v );
+        }
+        assert( distinct.size() == 1000 );
+    }
+    {   // sampling: sorted, distinct, the right size and roughly uniform
+        for ( auto const k : { 0, 1, 3, 50, 199, 200 } )
+        {
+            auto const a = roam::sample_k( roam::range{ 5, 605, 3 }, k, 9 );
+            auto got = std::vector< int >( a.begin(), a.end() );
+            assert( static_cast< int >( got.size() ) == k && a.size() == got.size() );
+            assert( std::adjacent_find( got.begin(), got.end(), std::greater_equal< int >{} ) == got.end() );
+            assert( std::all_of( got.begin(), got.end(), []( int const v ) { return roam::range{ 5, 605, 3 }.contains( v ); } ) );
+        }
+        auto hits = std::vector< int >( 100 );
+        for ( auto const seed : roam::range< uint64_t >{ 20000 } )
+        {
+            for ( auto const v : roam::sample_k( roam::range{ 100 }, 5, seed ) )
+            {
+                ++hits[ static_cast< std::size_t >( v ) ];
+            }
+        }
+        // each index expected 1000 times, std deviation ~31
+        assert( std::all_of( hits.begin(), hits.end(), []( int const c ) { return 850 < c && c < 1150; } ) );
+
+        auto kept = int64_t{ 0 };
+        auto last = int64_t{ -1 };
+        for ( auto const v : roam::sample_bernoulli( roam::range< int64_t >{ 10'000'000 }, 0.01, 5 ) )
+        {
+            assert( v > last );
+            last = v;
+            ++kept;
+        }
+        assert( 99'000 < kept && kept < 101'000 );
+        auto const none = roam::sample_bernoulli( roam::range{ 10 }, 0.0, 1 );
+        auto const all = roam::sample_bernoulli( roam::range{ 10 }, 1.0, 1 );
+        assert( none.begin() == none.end() && std::distance( all.begin(), all.end() ) == 10 );
+    }
+    {   // coarse to fine orders are permutations, materialize matches iteration
+        auto const a = roam::bit_reversed( roam::range{ 8 } );
+        assert( ( std::vector< int >( a.begin(), a.end() ) == std::vector< int >{ 0, 4, 2, 6, 1, 5, 3, 7 } ) );
+        auto const b = roam::low_discrepancy( roam::range{ 6 } );
+        assert( ( std::vector< int >( b.begin(), b.end() ) == std::vector< int >{ 0, 3, 1, 4, 2, 5 } ) );
+        auto const check = []( auto const& order, roam::range< int > const& r ) {
+            auto got = std::vector< int >( order.begin(), order.end() );
+            auto out = std::vector< int >( r.size() );
+            order.materialize( out.data() );
+            assert( got == out );
+            std::sort( got.begin(), got.end() );
+            assert( std::equal( got.begin(), got.end(), r.begin(), r.end() ) );
+        };
+        for ( auto const n : roam::range{ 0, 130 } )
+        {
+            check( roam::bit_reversed( roam::range{ 3, 3 + 2 * n, 2 } ), roam::range{ 3, 3 + 2 * n, 2 } );
+            check( roam::low_discrepancy( roam::range{ 3, 3 + 2 * n, 2 } ), roam::range{ 3, 3 + 2 * n, 2 } );
+        }
+        // every prefix of the scaled order is evenly spread: largest gap <= 2 * n / m
+        auto const n = 1000;
+        auto seen = std::set< int >{ -1, n };
+        for ( auto const v : roam::low_discrepancy( roam::range{ n } ) )
+        {
+            seen.insert( v );
+            auto gap = 0;
+            for ( auto it = seen.begin(), next = std::next( it ); next != seen.end(); ++it, ++next )
+            {
+                gap = std::max( gap, *next - *it );
+            }
+            assert( gap <= 2 * n / static_cast< int >( seen.size() - 2 ) + 2 );
+        }
+        // scaled index of huge ranges does not overflow
+        auto const big = roam::low_discrepancy( roam::range< int64_t >{ 3'000'000'000'000 } );
+        auto it = big.begin();
+        assert( *it == 0 && *++it == 1'500'000'000'000 && *++it == 750'000'000'000 );
+        // elements near the limits of int64_t, step * index alone overflows
+        auto const edge = roam::range< int64_t >{ INT64_MIN, INT64_MAX, INT64_MAX / 2 };
+        for ( auto const& order : { roam::bit_reversed( edge ), roam::bit_reversed( edge.slice( 0, 4 ) ) } )
+        {
+            auto out = std::vector< int64_t >( order.size() );
+            order.materialize( out.data() );
+            assert( ( out == std::vector< int64_t >( order.begin(), order.end() ) ) );
+            assert( *std::max_element( out.begin(), out.end() ) == edge[ static_cast< std::ptrdiff_t >( out.size() ) - 1 ] );
+        }
+    }
+    {   // range_set: random inserts / erases and set algebra agree with std::set
+        auto rng = std::mt19937{ 7 };
+        auto pick = std::uniform_int_distribution< int >{ 0, 200 };
+        auto a = roam::range_set< int >{};
+        auto b = roam::range_set< int >{ roam::range{ 50, 70 }, roam::range{ 120, 180 } };
+        auto ref_a = std::set< int >{};
+        auto ref_b = std::set< int >{};
+        for ( auto const v : b )
+        {
+            ref_b.insert( v );
+        }
+        for ( [[maybe_unused]] auto const _ : roam::range{ 200 } )
+        {
+            auto lo = pick( rng );
+            auto hi = pick( rng );
+            if ( lo > hi )
+            {
+                std::swap( lo, hi );
+            }
+            auto const add = pick( rng ) % 3 != 0;
+            add ? a.insert( lo, hi ) : a.erase( lo, hi );
+            for ( auto const v : roam::range{ lo, hi } )
+            {
+                if ( add )
+                {
+                    ref_a.insert( v );
+                }
+                else
+                {
+                    ref_a.erase( v );
+                }
+            }
+            assert( std::equal( a.begin(), a.end(), ref_a.begin(), ref_a.end() ) && a.size() == ref_a.size() );
+        }
+        for ( auto const v : roam::range{ -5, 205 } )
+        {
+            auto const in_a = ref_a.count( v ) != 0;
+            auto const in_b = ref_b.count( v ) != 0;
+            assert( a.contains( v ) == in_a );
+            assert( ( a | b ).contains( v ) == ( in_a || in_b ) );
+            assert( ( a & b ).contains( v ) == ( in_a && in_b ) );
+            assert( ( a - b ).contains( v ) == ( in_a && !in_b ) );
+            assert( ( a ^ b ).contains( v ) == ( in_a != in_b ) );
+        }
+        auto const both = a | b;
+        for ( auto const r : both.intervals() )
+        {
+            assert( both.contains( r ) && !both.contains( r.stop() ) );
+        }
+        // at the type's limits: sizes past INT64_MAX, the maximum is never a member
+        auto wide = roam::range_set< int64_t >{ roam::range< int64_t >{ INT64_MIN, INT64_MAX } };
+        assert( wide.size() == UINT64_MAX );
+        wide.erase( INT64_MAX );
+        wide.erase( INT64_MAX - 1 );
+        wide.insert( INT64_MAX - 1 );
+        assert( wide.intervals().size() == 1 && wide.contains( INT64_MAX - 1 ) && !wide.contains( INT64_MAX ) );
+        auto edge = roam::range_set< int8_t >{};
+        edge.insert( 126 );
+        edge.insert( -128 );
+        assert( edge.size() == 2 && edge.contains( 126 ) && edge.contains( -128 ) );
+    }
+    {   // index_bitmap: run, array and bitmap containers agree with range_set
+        auto a = roam::index_bitmap{};
+        auto b = roam::index_bitmap{};
+        auto ref_a = roam::range_set< int64_t >{};
+        auto ref_b = roam::range_set< int64_t >{};
+        a.add( roam::range< int64_t >{ 1000, 200000 } );                  // runs across chunks
+        ref_a.insert( 1000, 200000 );
+        for ( auto const v : roam::range< int64_t >{ 150000, 400000, 3 } ) // dense bitmap chunks
+        {
+            a.add( static_cast< uint32_t >( v ) );
+            ref_a.insert( v );
+        }
+        a.remove( 5000 );
+        ref_a.erase( 5000 );
+        b.add( roam::range< int64_t >{ 300000, 50000, -97 } );            // sparse array chunks
+        b.add( roam::range< int64_t >{ 190000, 210000 } );
+        for ( auto const v : roam::range< int64_t >{ 300000, 50000, -97 } )
+        {
+            ref_b.insert( v );
+        }
+        ref_b.insert( 190000, 210000 );
+        auto const same = []( roam::index_bitmap const& x, roam::range_set< int64_t > const& ref ) {
+            auto const runs = x.runs();
+            auto const intervals = ref.intervals();
+            if ( runs.size() != intervals.size() || x.size() != ref.size() )
+            {
+                return false;
+            }
+            for ( auto const i : roam::range{ runs.size() } )
+            {
+                if ( runs[ i ].start() != intervals[ i ].start() || runs[ i ].stop() != intervals[ i ].stop() )
+                {
+                    return false;
+                }
+            }
+            return std::equal( x.begin(), x.end(), ref.begin(), ref.end() );
+        };
+        assert( same( a, ref_a ) && same( b, ref_b ) );
+        assert( same( a | b, ref_a | ref_b ) && same( a & b, ref_a & ref_b ) && same( a - b, ref_a - ref_b ) );
+        assert( a.contains( 1000 ) && !a.contains( 5000 ) && !a.contains( 200002 ) && a.contains( 200004 ) );
+        auto c = a;
+        c.optimize();
+        assert( c == a && c.bytes() <= a.bytes() );
+
+        // stepped adds in either direction, equality across container kinds, array x run results
+        auto up = roam::index_bitmap{};
+        auto down = roam::index_bitmap{};
+        up.add( roam::range< int64_t >{ 50031, 300001, 97 } );
+        down.add( roam::range< int64_t >{ 300000, 50000, -97 } );
+        auto ref_down = roam::range_set< int64_t >{};
+        for ( auto const v : roam::range< int64_t >{ 300000, 50000, -97 } )
+        {
+            ref_down.insert( v );
+        }
+        assert( up == down && same( down, ref_down ) );
+        auto run = roam::index_bitmap{};
+        auto values = roam::index_bitmap{};
+        run.add( roam::range< int64_t >{ 0, 100 } );
+        for ( auto const v : roam::range< uint32_t >{ 100 } )
+        {
+            values.add( v );
+        }
+        assert( run == values );
+        values.remove( 42 );
+        values.add( 100 );
+        assert( run != values && run.size() == values.size() );
+        auto sparse = roam::index_bitmap{};
+        auto wide = roam::index_bitmap{};
+        wide.add( roam::range< int64_t >{ 0, 60000 } );
+        for ( auto const v : roam::range< uint32_t >{ 0, 60000, 300 } )
+        {
+            sparse.add( v );
+        }
+        auto const both = wide & sparse;
+        assert( both == sparse && both.bytes() <= sparse.bytes() && ( wide | sparse ) == wide && ( sparse - wide ).empty() );
+    }
+    {   // progression_list: round trip, random access and compression
+        auto rng = std::mt19937{ 5 };
+        auto idx = std::vector< uint32_t >{};
+        for ( auto const block : roam::range{ 200 } )
+        {
+            auto const start = static_cast< uint32_t >( rng() % 100000 );
+            auto const step = static_cast< int >( rng() % 4 ) + 1;
+            auto const count = rng() % 3 == 0 ? rng() % 5 : 20 + rng() % 200;
+            for ( auto const i : roam::range{ count } )
+            {
+                idx.push_back( static_cast< uint32_t >( block % 7 == 0 ? rng() : start + step * static_cast< int >( i ) ) );
+            }
+        }
+        auto const list = roam::progression_list< uint32_t >{ idx };
+        assert( list.size() == idx.size() && list.to_vector() == idx );
+        assert( std::equal( list.begin(), list.end(), idx.begin(), idx.end() ) );
+        for ( auto const i : roam::range{ 0, static_cast< int >( idx.size() ), 7 } )
+        {
+            assert( list[ i ] == idx[ i ] );
+        }
+        assert( list[ -1 ] == idx.back() );
+        assert( list.bytes() * 4 < idx.size() * sizeof( uint32_t ) );
+        auto const columns = roam::progression_list< uint32_t >{ std::vector< uint32_t >{ 3, 7, 11, 15, 19, 23, 27, 31, 2 } };
+        assert( columns.segments().size() == 2 && columns.segments()[ 0 ].run().size() == 8 );
+        auto const down = roam::progression_list< uint32_t >{ std::vector< uint32_t >{ 40, 35, 30, 25, 20, 15, 10, 5, 0 } };
+        assert( down.segments().size() == 1 && down.segments()[ 0 ].step == -5 && down[ 6 ] == 10 );
+        // extreme values: differences past int64_t, values past INT64_MAX and runs up to the limits
+        auto const check = []( auto const& values ) {
+            auto const codec = roam::progression_list< typename std::decay_t< decltype( values ) >::value_type >{ values };
+            assert( codec.to_vector() == values && std::equal( codec.begin(), codec.end(), values.begin(), values.end() ) );
+            auto expanded = std::size_t{ 0 };
+            codec.for_each_run( [&]( roam::range< int64_t > const& r ) { expanded += r.size(); } );
+            return expanded;
+        };
+        auto const s = int64_t{ 1 } << 61;
+        assert( check( std::vector< int64_t >{ INT64_MIN, INT64_MAX, INT64_MIN, INT64_MAX, INT64_MIN, INT64_MAX } ) == 0 );
+        assert( check( std::vector< int64_t >{ INT64_MIN + 1, INT64_MIN + 1 + s, INT64_MIN + 1 + 2 * s, -s + 1, 1, s + 1 } ) == 6 );
+        assert( check( std::vector< int64_t >{ INT64_MAX - 40, INT64_MAX - 30, INT64_MAX - 20, INT64_MAX - 10, INT64_MAX } ) == 4 );
+        assert( check( std::vector< uint64_t >{ UINT64_MAX, UINT64_MAX - 7, UINT64_MAX - 14, UINT64_MAX - 21, UINT64_MAX - 28, 0, 1, 2, 3 } ) == 4 );
+    }
+    {   // telemetry: per call site histograms of size and iterations, merged over threads
+        using enabled = roam::telemetry::enabled;
+        static_assert( std::is_same_v< decltype( roam::traced< roam::telemetry::disabled >( roam::range{ 3 } ) ), roam::range< int > > );
+        static_assert( std::is_same_v< decltype( roam::traced< roam::telemetry::disabled >( std::declval< std::vector< int >& >() ) ), std::vector< int >& > );
+        roam::telemetry::reset();
+        auto const loops = []() {
+            for ( auto const n : { 0, 3, 100 } )
+            {
+                for ( auto const i : roam::traced< enabled >( roam::range{ n } ) )
+                {
+                    if ( i == 50 )
+                    {
+                        break;
+                    }
+                }
+            }
+        };
+        loops();
+        auto worker = std::thread{ loops };
+        worker.join();
+        auto const reports = roam::telemetry::report();
+        assert( reports.size() == 1 && roam::telemetry::dropped() == 0 );
+        auto const& r = reports[ 0 ];
+        assert( std::strstr( r.where.file, "main.cpp" ) != nullptr && r.where.line != 0 );
+        assert( r.loops == 6 && r.size_total == 206 && r.iterations_total == 108 );
+        assert( r.sizes[ 0 ] == 2 && r.sizes[ 2 ] == 2 && r.sizes[ 7 ] == 2 );           // 0, 3 in [ 2, 4 ), 100 in [ 64, 128 )
+        assert( r.iterations[ 0 ] == 2 && r.iterations[ 2 ] == 2 && r.iterations[ 6 ] == 2 );   // 51 in [ 32, 64 )
+        auto const buffers = roam::telemetry::buffers();
+        for ( auto k = 0; k < 8; ++k )
+        {   // exited threads hand their buffer on, their counts stay
+            std::thread{ loops }.join();
+        }
+        assert( roam::telemetry::buffers() == buffers && roam::telemetry::report()[ 0 ].loops == 30 );
+        auto v = std::vector< int >{ 1, 2, 3 };
+        for ( auto& x : roam::traced< enabled >( v ) )
+        {
+            x *= 2;
+        }
+        assert( v[ 2 ] == 6 && roam::telemetry::report().size() == 2 );
+        roam::telemetry::reset();
+        assert( roam::telemetry::report()[ 0 ].loops == 0 );
+    }
 }
 
 int main()
 {
+    runtime_unit_tests();
+
     auto a = roam::range< int32_t >{ 5u, 10u };
     auto b = roam::range< int8_t >{ 10u };
 
@@ -0,0 +1,65 @@
+// example module.cpp
+//
+// imports roam.range instead of including range.h, built by example/module.sh
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+// after the standard headers, g++ 12 redefines them when they follow the import
+import roam.range;
+
+constexpr auto module_constexpr_tests() -> bool
+{
+    static_assert( roam::range{ 0, 10, 2 }.size() == 5 );
+    static_assert( roam::range{ 10, 0, -3 }[ -1 ] == 1 );
+    static_assert( roam::gsl::narrow< std::uint8_t >( 200 ) == 200 );
+    return true;
+}
+
+void module_runtime_tests()
+{
+    {   // iteration, forwards and reversed, over the deduced range types
+        auto sum = 0;
+        for ( auto const i : roam::range{ 0, 10, 2 } )
+        {
+            sum += i;
+        }
+        for ( auto const i : roam::range{ 5 }.reversed() )
+        {
+            sum -= i;
+        }
+        assert( sum == 10 );
+        enum class stage { parse, plan, run };
+        assert( roam::range{ stage::run }.size() == 2 );
+    }
+    {   // min_range and narrow with their default policies
+        struct buffer
+        {
+            auto size() const -> std::size_t { return 10; }
+        };
+        assert( roam::min_range( buffer{}, std::size_t{ 4 } ).size() == 4 );
+        assert( roam::gsl::narrow< int >( 5L ) == 5 );
+    }
+    {   // policies and errors come with the module
+        auto caught = false;
+        try
+        {
+            [[maybe_unused]] auto const v = roam::range< int, roam::checking::throwing >{ 3 }[ 5 ];
+        }
+        catch ( roam::out_of_range_error const& )
+        {
+            caught = true;
+        }
+        assert( caught );
+    }
+}
+
+int main()
+{
+    static_assert( module_constexpr_tests() );
+    module_runtime_tests();
+    std::cout << "module tests passed\n";
+    return 0;
+}
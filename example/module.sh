@@ -0,0 +1,55 @@
+#!/usr/bin/env bash
+# module.sh
+#
+# builds the roam.range module ( range.cppm ) into a bmi and object file with each compiler
+# found, then builds and runs example/module.cpp, which imports it
+#   g++:     g++ -std=c++20 -fmodules-ts -x c++ -c range.cppm            ( bmi in gcm.cache/ )
+#   clang++: clang++ -std=c++20 --precompile range.cppm -o roam.range.pcm, then -c the pcm,
+#            importers pass -fmodule-file=roam.range=roam.range.pcm
+# usage: example/module.sh [ compiler ... ]      ( default: g++ clang++, missing ones skipped )
+# exit code is the number of failed builds
+#=============================================================================
+
+set -u
+
+here="$( cd "$( dirname "$0" )" && pwd )"
+root="$( cd "$here/.." && pwd )"
+tmp="$( mktemp -d )"
+trap 'rm -rf "$tmp"' EXIT
+
+compilers="${*:-g++ clang++}"
+
+failures=0
+for cxx in $compilers; do
+    if ! command -v "$cxx" > /dev/null 2>&1; then
+        echo "skip: $cxx not found"
+        continue
+    fi
+    out="$tmp/${cxx//+/x}"
+    mkdir -p "$out"
+    case "${cxx##*/}" in
+        *clang*)
+            build() {
+                "$cxx" -std=c++20 -I"$root" --precompile "$root/range.cppm" -o "$out/roam.range.pcm" &&
+                "$cxx" -std=c++20 -c "$out/roam.range.pcm" -o "$out/range.o" &&
+                "$cxx" -std=c++20 -fmodule-file=roam.range="$out/roam.range.pcm" "$here/module.cpp" "$out/range.o" -o "$out/module"
+            } ;;
+        *)
+            # g++ writes and reads the bmi in gcm.cache/ of the working directory
+            build() {
+                ( cd "$out" &&
+                  "$cxx" -std=c++20 -fmodules-ts -I"$root" -x c++ -c "$root/range.cppm" -o range.o &&
+                  "$cxx" -std=c++20 -fmodules-ts "$here/module.cpp" range.o -o module )
+            } ;;
+    esac
+    if ! build; then
+        echo "FAIL: $cxx does not build the roam.range module"
+        failures=$(( failures + 1 ))
+    elif ! "$out/module"; then
+        echo "FAIL: $cxx module tests"
+        failures=$(( failures + 1 ))
+    else
+        echo "ok: $cxx"
+    fi
+done
+exit "$failures"
@@ -0,0 +1,38 @@
+// range.cppm
+//
+// c++20 module interface of range.h, 'import roam.range;' instead of '#include "range.h"'
+// the header is parsed once into the module's bmi ( built module interface ) and importers load
+// the bmi. everything range.h declares is exported: range with its deduction guides, min_range,
+// gsl::narrow, the checking policies and the error types
+// e.g.
+//     import roam.range;
+//     for ( auto const i : roam::range{ 0, 10, 2 } ) { do_smth( i ); }
+// build: example/module.sh builds the bmi and example/module.cpp, which imports it, with g++
+// ( -fmodules-ts ) and clang++ ( --precompile )
+// @note: a translation unit either imports the module or includes the header, g++ 12 sees two
+//        different roam::range when it does both. g++ 12 also wants standard headers included
+//        before the import
+//=============================================================================
+
+module;
+
+// the standard headers of range.h, included here so they stay out of the module purview
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+export module roam.range;
+
+//-----------------------------------------------------------------------------
+
+// extern "C++" keeps the declarations in the global module, the same entities the header declares
+export extern "C++"
+{
+#include "range.h"
+}
@@ -10,24 +10,166 @@
 #ifndef _INC_ROAM_RANGE_H_
 #define _INC_ROAM_RANGE_H_
 
-#include <algorithm>   // currently for min_range utility
-
 #include <cassert>
-#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <exception>   // for gsl::narrowing_error
+#include <iterator>    // for the iterator tags
+#include <limits>      // for floating point membership tolerance
+#include <stdexcept>   // for the bases of the range_error types
 #include <type_traits> // for enum ctor and narrowing
+#include <utility>     // for std::forward and std::declval
 
 //-----------------------------------------------------------------------------
 
 namespace roam
 {
 
+// checking policies for range and gsl::narrow
+// asserted    every construction, element access and conversion is checked with assert ( default )
+// unchecked   nothing is checked
+// throwing    everything is checked, failures throw
+// saturating  nothing fails: invalid ranges are empty, indices and conversions clamp to the valid values
+// validated   construction is checked ( and throws ) so element access and conversion need no checks,
+//             for hardened release builds
+namespace checking
+{
+    struct unchecked {};
+    struct asserted {};
+    struct throwing {};
+    struct saturating {};
+    struct validated {};
+} // checking
+
+// errors thrown by the throwing and validated policies. each derives from its <stdexcept>
+// counterpart, for catch ( std::exception const& ) handlers, and from range_error, their common base
+class range_error
+{
+public:
+    explicit range_error( char const* const what ) :
+        what_{ what }
+    {
+    }
+    virtual ~range_error() = default;
+    [[nodiscard]] virtual auto what() const noexcept -> char const*
+    {
+        return what_;
+    }
+
+private:
+    char const* what_{};
+};
+
+class invalid_range_error : public std::invalid_argument, public range_error
+{   // zero step, or stop behind start for the step direction
+public:
+    explicit invalid_range_error( char const* const what ) :
+        std::invalid_argument{ what },
+        range_error{ what }
+    {
+    }
+    [[nodiscard]] auto what() const noexcept -> char const* override
+    {
+        return range_error::what();
+    }
+};
+
+class out_of_range_error : public std::out_of_range, public range_error
+{   // element access outside the range
+public:
+    explicit out_of_range_error( char const* const what ) :
+        std::out_of_range{ what },
+        range_error{ what }
+    {
+    }
+    [[nodiscard]] auto what() const noexcept -> char const* override
+    {
+        return range_error::what();
+    }
+};
+
+class range_length_error : public std::length_error, public range_error
+{   // more elements than std::ptrdiff_t indexes
+public:
+    explicit range_length_error( char const* const what ) :
+        std::length_error{ what },
+        range_error{ what }
+    {
+    }
+    [[nodiscard]] auto what() const noexcept -> char const* override
+    {
+        return range_error::what();
+    }
+};
+
+namespace detail
+{
+    template < typename policy_t, typename error_t >
+    constexpr void require( [[maybe_unused]] bool const ok, [[maybe_unused]] char const* const what )
+    {   // report a failed check according to 'policy_t'
+        if constexpr ( std::is_same_v< policy_t, checking::asserted > ) {
+            assert( ok && what );
+        }
+        else if constexpr ( std::is_same_v< policy_t, checking::throwing > || std::is_same_v< policy_t, checking::validated > ) {
+            if ( !ok ) {
+                throw error_t{ what };
+            }
+        }
+    }
+} // detail
+
 namespace gsl
 {
+    class narrowing_error : public std::exception
+    {
+    public:
+        explicit narrowing_error( char const* const what ) :
+            what_{ what }
+        {
+        }
+        [[nodiscard]] auto what() const noexcept -> char const* override
+        {
+            return what_;
+        }
+
+    private:
+        char const* what_{};
+    };
+
+    // true when every value of 'from_t' converts to 'to_t' and back unchanged
+    template < typename to_t, typename from_t >
+    [[nodiscard]] constexpr auto value_preserving() -> bool
+    {
+        using to_lim = std::numeric_limits< to_t >;
+        using from_lim = std::numeric_limits< from_t >;
+        if constexpr ( std::is_same_v< to_t, from_t > ) {
+            return true;
+        }
+        else if constexpr ( !to_lim::is_specialized || !from_lim::is_specialized ) {
+            return false;
+        }
+        else if constexpr ( from_lim::is_integer && to_lim::is_integer ) {
+            // digits excludes the sign bit
+            return ( to_lim::is_signed || !from_lim::is_signed ) && to_lim::digits >= from_lim::digits;
+        }
+        else if constexpr ( from_lim::is_integer ) {
+            return to_lim::digits >= from_lim::digits;
+        }
+        else if constexpr ( !to_lim::is_integer ) {
+            return to_lim::digits >= from_lim::digits && to_lim::max_exponent >= from_lim::max_exponent;
+        }
+        else {
+            return false;
+        }
+    }
+    template < typename to_t, typename from_t >
+    inline auto constexpr is_value_preserving_v = value_preserving< to_t, from_t >();
+
     // [gsl] narrowing
     template < typename ty1_t, typename ty2_t >
     [[nodiscard]] constexpr auto is_narrow( ty1_t const& a, ty2_t const& b ) -> bool
     {   // test for narrowed conversion: 'a' and 'b' are NOT the same value
-        if ( static_cast< ty1_t >( b ) != a ) {
+        if ( static_cast< ty2_t >( a ) != b ) {
             return true;
         }
         auto constexpr same_signedness = ( std::is_signed_v< ty1_t > == std::is_signed_v< ty2_t > );
@@ -37,70 +179,451 @@ namespace gsl
         return false;
     }
 
+    template < typename to_t, typename from_t >
+    [[nodiscard]] constexpr auto saturate( from_t const& v ) -> to_t
+    {   // @return 'v' clamped to the range of 'to_t', NaN converts to 0
+        using to_lim = std::numeric_limits< to_t >;
+        if constexpr ( !to_lim::is_integer ) {
+            return static_cast< to_t >( v );
+        }
+        else if constexpr ( !std::numeric_limits< from_t >::is_integer ) {
+            if ( v != v ) {
+                return to_t{};
+            }
+            if ( v <= static_cast< from_t >( to_lim::lowest() ) ) {
+                return to_lim::lowest();
+            }
+            if ( v >= static_cast< from_t >( to_lim::max() ) ) {
+                return to_lim::max();
+            }
+            return static_cast< to_t >( v );
+        }
+        else {
+            if ( v < from_t{} ) {
+                if constexpr ( !to_lim::is_signed ) {
+                    return to_t{};
+                }
+                else if ( static_cast< std::intmax_t >( v ) < static_cast< std::intmax_t >( to_lim::lowest() ) ) {
+                    return to_lim::lowest();
+                }
+                return static_cast< to_t >( v );
+            }
+            if ( static_cast< std::uintmax_t >( v ) > static_cast< std::uintmax_t >( to_lim::max() ) ) {
+                return to_lim::max();
+            }
+            return static_cast< to_t >( v );
+        }
+    }
+
+    template < typename ty1_t, typename policy_t, typename ty2_t >
+    constexpr auto narrow( ty2_t&& v ) -> ty1_t
+    {   // @return 'v' converted to 'ty1_t', checked according to 'policy_t'
+        // @note: conversions that preserve every value compile to a plain cast under any policy
+        using from_t = std::decay_t< ty2_t >;
+        if constexpr ( is_value_preserving_v< ty1_t, from_t > ||
+                       std::is_same_v< policy_t, checking::unchecked > ||
+                       std::is_same_v< policy_t, checking::validated > ) {
+            return static_cast< ty1_t >( std::forward< ty2_t >( v ) );
+        }
+        else if constexpr ( std::is_same_v< policy_t, checking::saturating > ) {
+            return saturate< ty1_t >( static_cast< from_t >( v ) );
+        }
+        else {
+            auto const ret = static_cast< ty1_t >( std::forward< ty2_t >( v ) );
+            detail::require< policy_t, narrowing_error >( !is_narrow( ret, v ), "narrowing conversion" );
+            return ret;
+        }
+    }
+    // asserted by default, an overload rather than a default template argument before the
+    // deduced 'ty2_t', which g++ 12 drops when narrow comes from the roam.range module
     template < typename ty1_t, typename ty2_t >
     constexpr auto narrow( ty2_t&& v ) -> ty1_t
     {
-        auto const ret = static_cast< ty1_t >( std::forward< ty2_t >( v ) );
-        assert( !is_narrow( ret, v ) );
-        return ret;
+        return narrow< ty1_t, checking::asserted >( std::forward< ty2_t >( v ) );
     }
 } // gsl
 
+namespace detail
+{
+    // bidirectional iterator over anything with operator[]( std::ptrdiff_t ), used by the
+    // companion range types. holds a pointer to its source and is invalidated if it is destroyed
+    template < typename src_t >
+    class index_iterator
+    {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::decay_t< decltype( std::declval< src_t const& >()[ 0 ] ) >;
+        using reference = value_type;
+        using pointer = value_type*;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        explicit index_iterator( src_t const& src, std::ptrdiff_t const& idx ) :
+            src_{ &src },
+            idx_{ idx }
+        {
+        }
+
+        [[nodiscard]] auto operator==( index_iterator const& rhs ) const -> bool {
+            return src_ == rhs.src_ && idx_ == rhs.idx_;
+        }
+        [[nodiscard]] auto operator!=( index_iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> index_iterator& {
+            ++idx_;
+            return *this;
+        }
+        auto operator++( int ) -> index_iterator {
+            auto const ret = *this;
+            ++idx_;
+            return ret;
+        }
+        auto operator--() -> index_iterator& {
+            --idx_;
+            return *this;
+        }
+        auto operator--( int ) -> index_iterator {
+            auto const ret = *this;
+            --idx_;
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() const -> reference {
+            return ( *src_ )[ idx_ ];
+        }
+
+    private:
+        src_t const* src_{};
+        std::ptrdiff_t idx_{};
+    };
+
+    template < typename ty_t >
+    [[nodiscard]] constexpr auto abs_diff( ty_t const& a, ty_t const& b ) -> std::make_unsigned_t< ty_t >
+    {   // @return | a - b | in the unsigned type, exact across the full value range
+        using uty_t = std::make_unsigned_t< ty_t >;
+        return a < b ? static_cast< uty_t >( static_cast< uty_t >( b ) - static_cast< uty_t >( a ) )
+                     : static_cast< uty_t >( static_cast< uty_t >( a ) - static_cast< uty_t >( b ) );
+    }
+
+    template < typename policy_t, typename ty_t >
+    [[nodiscard]] constexpr auto float_count( ty_t const start, ty_t const stop, ty_t const step ) -> std::size_t
+    {   // @return number of indices i whose element start + step * i, rounded exactly as range::operator[]
+        //         rounds it, lies before 'stop'; so element size() - 1 is always before 'stop'
+        // @note: elements are monotone in i, the quotient is only a first guess corrected by an
+        //        exponential search from it, usually a single extra evaluation
+        // @note: a count past std::ptrdiff_t ( an infinite stop included ) is reported through
+        //        'policy_t', policies that do not stop there get PTRDIFF_MAX
+        auto const before = [&]( std::size_t const i ) {
+            auto const v = start + static_cast< ty_t >( step * static_cast< ty_t >( i ) );
+            return step > ty_t{ 0 } ? v < stop : v > stop;
+        };
+        auto const q = ( stop - start ) / step;
+        if ( !( q > ty_t{ 0 } ) ) {
+            return 0;
+        }
+        // @requires: a count that fits std::ptrdiff_t
+        auto const fits = q < static_cast< ty_t >( PTRDIFF_MAX );
+        require< policy_t, range_length_error >( fits, "range size exceeds ptrdiff_t" );
+        if ( !fits ) {
+            return static_cast< std::size_t >( PTRDIFF_MAX );
+        }
+        auto const guess = static_cast< std::size_t >( q );
+        // bracket the first index that is not before 'stop' in [lo, hi]
+        auto lo = std::size_t{ 0 };
+        auto hi = guess;
+        auto d = std::size_t{ 1 };
+        if ( before( guess ) ) {
+            lo = guess + 1;
+            while ( before( guess + d ) ) {
+                lo = guess + d + 1;
+                d *= 2;
+            }
+            hi = guess + d;
+        }
+        else {
+            while ( d <= guess && !before( guess - d ) ) {
+                hi = guess - d;
+                d *= 2;
+            }
+            lo = d <= guess ? guess - d + 1 : 0;
+        }
+        while ( lo < hi ) {
+            auto const mid = lo + ( hi - lo ) / 2;
+            if ( before( mid ) ) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+} // detail
+
 // range class
-template < typename ty_t >
+// 'policy_t' selects how construction, element access and conversions are checked ( see checking )
+template < typename ty_t, typename policy_t = checking::asserted >
 class range
 {
+    // checks made per element, a validated range was fully checked when constructed
+    using access_policy = std::conditional_t< std::is_same_v< policy_t, checking::validated >, checking::unchecked, policy_t >;
+    static auto constexpr checked_access = std::is_same_v< access_policy, checking::asserted > ||
+                                           std::is_same_v< access_policy, checking::throwing >;
+
 public:
     using value_type = ty_t;
+    using policy_type = policy_t;
 
     constexpr explicit range( ty_t const& start, ty_t const& stop, ty_t const& step = ty_t{ 1 } ) :
         start_{ start },
         stop_{ stop },
         step_{ step }
     {   // @example: range{ 0, 5[, 1] }
-        // @requires: non-zero step size
-        assert( step_ != ty_t{ 0 } );
-        // @requires valid range and step
-        assert( ( start_ <= stop_ && step_ > ty_t{ 0 } ) ||
-                ( start_ >= stop_ && step_ < ty_t{ 0 } ) );
+        auto const valid = ( start_ <= stop_ && step_ > ty_t{ 0 } ) ||
+                           ( start_ >= stop_ && step_ < ty_t{ 0 } );
+        if constexpr ( std::is_same_v< policy_t, checking::saturating > ) {
+            // invalid ranges are empty
+            if ( !valid ) {
+                step_ = step_ == ty_t{ 0 } ? ty_t{ 1 } : step_;
+                stop_ = start_;
+            }
+        }
+        else {
+            // @requires: non-zero step size
+            detail::require< policy_t, invalid_range_error >( step_ != ty_t{ 0 }, "range step is zero" );
+            // @requires valid range and step
+            detail::require< policy_t, invalid_range_error >( valid, "range stop is behind start for the step direction" );
+        }
+        if constexpr ( std::is_same_v< policy_t, checking::validated > ) {
+            // every index must fit std::ptrdiff_t for access to go unchecked
+            detail::require< policy_t, range_length_error >( size() <= static_cast< std::size_t >( PTRDIFF_MAX ), "range size exceeds ptrdiff_t" );
+        }
     }
     constexpr explicit range( ty_t const& stop ) : range{ ty_t{ 0 }, stop }
     {   // @example: range{ 5 }
     }
     template < typename ty2_t >
-    constexpr explicit range( ty2_t const& stop ) : range{ gsl::narrow< ty_t >( stop ) }
+    constexpr explicit range( ty2_t const& stop ) : range{ gsl::narrow< ty_t, policy_t >( stop ) }
     {   // enable implicit conversion of input type to desired
         // @example: range< int64_t >{ 10u }
     }
+    template < typename other_t >
+    constexpr explicit range( range< ty_t, other_t > const& other ) : range{ other.start(), other.stop(), other.step() }
+    {   // same values under another checking policy
+        // @example: range< int, checking::validated >{ range{ 0, 10 } }
+    }
 
     [[nodiscard]] constexpr auto size() const -> std::size_t
     {   // @return number of steps in range
         // @example1: range{ 5 }.size() == 5
         // @example2: range{ 2, 5, 3 }.size() == 1
         // @example3: range{ 1, 2, 10 }.size() == 1
-        auto const sz = static_cast< std::ptrdiff_t >( ( stop_ - start_ ) / step_ );
-        auto const v = start_ + static_cast< ty_t >( sz * step_ );
-        return static_cast< std::size_t >( v == stop_ ? sz : sz + 1 );
+        if constexpr ( std::is_integral_v< ty_t > ) {
+            // unit steps are a subtraction, any other step a single unsigned division
+            auto const dist = detail::abs_diff( start_, stop_ );
+            auto const stride = detail::abs_diff( step_, ty_t{ 0 } );
+            if ( stride == 1 ) {
+                return static_cast< std::size_t >( dist );
+            }
+            return static_cast< std::size_t >( dist / stride + ( dist % stride != 0 ? 1 : 0 ) );
+        }
+        else {
+            // exact for the elements operator[] produces, independent of how the quotient rounds
+            return detail::float_count< policy_t >( start_, stop_, step_ );
+        }
     }
     [[nodiscard]] constexpr auto empty() const -> bool
     {
         return 0 == size();
     }
+    [[nodiscard]] constexpr auto start() const -> ty_t
+    {
+        return start_;
+    }
+    [[nodiscard]] constexpr auto stop() const -> ty_t
+    {
+        return stop_;
+    }
+    [[nodiscard]] constexpr auto step() const -> ty_t
+    {
+        return step_;
+    }
     [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx_in ) const -> ty_t
     {   // @return index of range, range[0] is always start
         // @note: range[-1] is last possible step < end (e.g. range{ 0, 5, 2 }[-1] == 4 )
-        auto const idx = idx_in >= 0 ? idx_in : gsl::narrow< std::ptrdiff_t >( size() ) + idx_in;
-        auto const ret = start_ + gsl::narrow< ty_t >( step_ * idx );
-        // @requires: valid index
-        assert( ( ret >= start_ && ret < stop_ && step_ > ty_t{ 0 } ) ||
-                ( ret <= start_ && ret > stop_ && step_ < ty_t{ 0 } ) );
-        return ret;
+        // @note: saturating ranges clamp out of range indices to the first or last element
+        if constexpr ( std::is_same_v< access_policy, checking::saturating > ) {
+            auto const n = gsl::narrow< std::ptrdiff_t, access_policy >( size() );
+            auto idx = idx_in >= 0 ? idx_in : n + idx_in;
+            idx = idx >= n ? n - 1 : idx;
+            idx = idx < 0 ? 0 : idx;
+            if constexpr ( std::is_integral_v< ty_t > ) {
+                return element( idx );
+            }
+            else {
+                return start_ + gsl::narrow< ty_t, access_policy >( step_ * idx );
+            }
+        }
+        else if constexpr ( std::is_integral_v< ty_t > ) {
+            // the offset step * idx may not fit ty_t ( or even overflow ) where the element does,
+            // so check the index and compute the element modulo 2^64
+            auto const n = gsl::narrow< std::ptrdiff_t, access_policy >( size() );
+            auto const idx = idx_in >= 0 ? idx_in : n + idx_in;
+            if constexpr ( checked_access ) {
+                // @requires: valid index
+                detail::require< access_policy, out_of_range_error >( 0 <= idx && idx < n, "range index out of range" );
+            }
+            return element( idx );
+        }
+        else {
+            auto const idx = idx_in >= 0 ? idx_in : gsl::narrow< std::ptrdiff_t, access_policy >( size() ) + idx_in;
+            auto const ret = start_ + gsl::narrow< ty_t, access_policy >( step_ * idx );
+            if constexpr ( checked_access ) {
+                // @requires: valid index
+                detail::require< access_policy, out_of_range_error >( ( ret >= start_ && ret < stop_ && step_ > ty_t{ 0 } ) ||
+                                                                      ( ret <= start_ && ret > stop_ && step_ < ty_t{ 0 } ), "range index out of range" );
+            }
+            return ret;
+        }
+    }
+
+    // membership, O(1)
+    [[nodiscard]] constexpr auto index_of( ty_t const& v ) const -> std::ptrdiff_t
+    {   // @return index of value 'v' or -1 if 'v' is not in range, inverse of operator[]
+        // @example: range{ 10, 0, -2 }.index_of( 4 ) == 3
+        // @note: floating point values match within a few ulps of the nearest step
+        if constexpr ( std::is_floating_point_v< ty_t > ) {
+            auto const mag = ( start_ < ty_t{ 0 } ? -start_ : start_ ) + ( v < ty_t{ 0 } ? -v : v );
+            return index_of( v, 4 * std::numeric_limits< ty_t >::epsilon() * mag );
+        }
+        else {
+            auto const up = step_ > ty_t{ 0 };
+            if ( up ? ( v < start_ || v >= stop_ ) : ( v > start_ || v <= stop_ ) ) {
+                return -1;
+            }
+            // distance and stride in the unsigned type, exact even across the full value range
+            auto const dist = detail::abs_diff( v, start_ );
+            auto const stride = detail::abs_diff( step_, ty_t{ 0 } );
+            if ( stride == 1 ) {
+                return static_cast< std::ptrdiff_t >( dist );
+            }
+            return dist % stride == 0 ? static_cast< std::ptrdiff_t >( dist / stride ) : -1;
+        }
+    }
+    [[nodiscard]] constexpr auto index_of( ty_t const& v, ty_t const& tolerance ) const -> std::ptrdiff_t
+    {   // @return index of the step within 'tolerance' of floating point value 'v' or -1
+        static_assert( std::is_floating_point_v< ty_t >, "tolerance is for floating point ranges" );
+        auto const q = ( v - start_ ) / step_;
+        auto const n = size();
+        if ( !( q > ty_t{ -0.5 } && q < static_cast< ty_t >( n ) - ty_t{ 0.5 } ) ) {
+            return -1;
+        }
+        auto const k = static_cast< std::ptrdiff_t >( q + ty_t{ 0.5 } );
+        auto const err = start_ + step_ * static_cast< ty_t >( k ) - v;
+        return ( err < ty_t{ 0 } ? -err : err ) <= tolerance ? k : -1;
+    }
+    [[nodiscard]] constexpr auto contains( ty_t const& v ) const -> bool
+    {   // @example: range{ 0, 10, 3 }.contains( 9 ) == true
+        return index_of( v ) >= 0;
+    }
+    [[nodiscard]] constexpr auto count( ty_t const& v ) const -> std::size_t
+    {   // @return occurrences of 'v', 0 or 1 ( python range.count )
+        return contains( v ) ? 1 : 0;
+    }
+
+    // derived ranges, O(1)
+    [[nodiscard]] constexpr auto slice( std::ptrdiff_t start, std::ptrdiff_t stop, std::ptrdiff_t const step = 1 ) const -> range
+    {   // @return range[start:stop:step] with python slice semantics
+        // @example1: range{ 0, 100, 3 }.slice( 5, 20, 2 ) == range{ 15, 60, 6 }
+        // @example2: range{ 10 }.slice( -3, 100 ) == range{ 7, 10 }
+        // @note: negative indices count from the end and out of range indices are clamped,
+        //        use stop = -size() - 1 to slice a negative step through to the front
+        // @requires: non-zero step size
+        // @requires: for integral types the new step and an exclusive stop are representable, not
+        //            so when two elements of the slice are further apart than the type allows or
+        //            its last element is the type's limit in the slice's direction. saturating
+        //            drops the elements past the first or the last element
+        detail::require< policy_t, invalid_range_error >( step != 0, "slice step is zero" );
+        auto const n = gsl::narrow< std::ptrdiff_t, access_policy >( size() );
+        auto const clamp = [&]( std::ptrdiff_t i ) {
+            i = i < 0 ? i + n : i;
+            return step > 0 ? ( i < 0 ? 0 : i > n ? n : i ) : ( i < -1 ? -1 : i > n - 1 ? n - 1 : i );
+        };
+        start = clamp( start );
+        stop = clamp( stop );
+        // @requires: descending slices of unsigned ranges are not representable
+        detail::require< policy_t, invalid_range_error >( step > 0 || std::is_signed_v< ty_t >, "descending slice of an unsigned range" );
+        if constexpr ( std::is_integral_v< ty_t > ) {
+            // the new step is scaled in the unsigned type and the stop is an element, stop_ or one
+            // step before start_, so nothing is computed past the type's limits
+            auto const count = step > 0 ? ( stop - start + step - 1 ) / step : ( start - stop - step - 1 ) / -step;
+            auto const descending = ( step_ < 0 ) != ( step < 0 );
+            auto const stride = static_cast< std::uint64_t >( detail::abs_diff( step_, ty_t{ 0 } ) );
+            auto const scale = static_cast< std::uint64_t >( step > 0 ? step : -step );
+            auto const limit = static_cast< std::uint64_t >( std::numeric_limits< ty_t >::max() ) + ( descending ? 1 : 0 );
+            auto const fits = stride <= limit / scale;
+            auto const new_step = static_cast< ty_t >( descending ? 0 - stride * scale : stride * scale );
+            if ( count <= 0 ) {
+                auto const first = start >= 0 && start < n ? element( start ) : start_;
+                return range{ first, first, fits ? new_step : step > 0 ? step_ : negated_step() };
+            }
+            detail::require< policy_t, invalid_range_error >( fits || count == 1, "slice step is not representable" );
+            auto const bound = [&]( std::ptrdiff_t const i ) { return i >= n ? stop_ : i < 0 ? before_start() : element( i ); };
+            if ( !fits ) {
+                // a single element, a unit step past it is representable unless it is the type's limit
+                auto const x = element( start );
+                auto const edge = descending ? std::numeric_limits< ty_t >::lowest() : std::numeric_limits< ty_t >::max();
+                auto const unit = descending ? static_cast< ty_t >( -1 ) : ty_t{ 1 };
+                detail::require< policy_t, invalid_range_error >( x != edge, "slice stop is not representable" );
+                return x == edge ? range{ x, x, unit } : range{ x, static_cast< ty_t >( x + unit ), unit };
+            }
+            // the clamped stop before start_ excludes the last element only when it is the type's limit
+            auto const last = element( start + ( count - 1 ) * step );
+            auto const stop_value = bound( stop );
+            detail::require< policy_t, invalid_range_error >( stop_value != last, "slice stop is not representable" );
+            return range{ element( start ), stop_value, new_step };
+        }
+        else {
+            auto const new_step = static_cast< ty_t >( step_ * static_cast< ty_t >( step ) );
+            auto const first = static_cast< ty_t >( start_ + step_ * static_cast< ty_t >( start ) );
+            if ( step > 0 ? stop <= start : stop >= start ) {
+                return range{ first, first, new_step };
+            }
+            return range{ first, static_cast< ty_t >( start_ + step_ * static_cast< ty_t >( stop ) ), new_step };
+        }
+    }
+    [[nodiscard]] constexpr auto reversed() const -> range
+    {   // @return the same values in reverse order
+        // @example: range{ 0, 10, 3 }.reversed() == range{ 9, -3, -3 }
+        // @requires: for integral types the reversed step and an exclusive stop are representable,
+        //            not so when more than one element is a step of the type's minimum apart or
+        //            the range starts at the type's limit in the reversed direction, e.g.
+        //            range< int8_t >{ -128, 0 }. saturating clamps them, dropping the unreachable
+        //            first element
+        static_assert( std::is_signed_v< ty_t >, "reversed range needs a signed ( or floating point ) type" );
+        if constexpr ( std::is_integral_v< ty_t > ) {
+            return slice( -1, -gsl::narrow< std::ptrdiff_t, access_policy >( size() ) - 1, -1 );
+        }
+        else {
+            if ( empty() ) {
+                return range{ start_, start_, static_cast< ty_t >( -step_ ) };
+            }
+            return range{ ( *this )[ -1 ], static_cast< ty_t >( start_ - step_ ), static_cast< ty_t >( -step_ ) };
+        }
     }
 
     // iteration
     // @note: iteration is NOT constexpr as you can't loop at compile time
-    class iterator
+    template < std::ptrdiff_t dir >
+    class basic_iterator
     {   // iterator holds reference to range and is invalidated if range destroyed
+        // dir is +1 for forward and -1 for reverse iteration, the reverse iterator indexes
+        // the range directly rather than decrementing a copy on every dereference
+        // integral iterators carry the current value and add the step, the same induction
+        // variable as a raw for loop so loops vectorize, without a raw loop's overflow when the
+        // range ends within one step of the type's limit. floating point iterators index the
+        // range, the values stay exactly operator[]'s
     public:
         using difference_type = std::ptrdiff_t;
         using value_type = ty_t;
@@ -108,65 +631,123 @@ public:
         using pointer = ty_t*;
         using iterator_category = std::bidirectional_iterator_tag;
 
-        explicit iterator( range< ty_t > const& range, std::ptrdiff_t const& idx ) :
+        explicit basic_iterator( range const& range, std::ptrdiff_t const& idx ) :
             range_{ range },
-            idx_{ idx }
+            idx_{ idx },
+            value_{ range.element( idx ) }
         {
         }
 
-        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+        [[nodiscard]] auto operator==( basic_iterator const& rhs ) const -> bool {
             return &range_ == &rhs.range_ && idx_ == rhs.idx_;
         }
-        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+        [[nodiscard]] auto operator!=( basic_iterator const& rhs ) const -> bool {
             return !( *this == rhs );
         }
 
-        auto operator++() -> iterator& {
-            ++idx_;
+        auto operator++() -> basic_iterator& {
+            advance< dir >();
             return *this;
         }
-        auto operator++( int ) -> iterator {
+        auto operator++( int ) -> basic_iterator {
             auto const ret = *this;
-            ++idx_;
+            advance< dir >();
             return ret;
         }
-        auto operator--() -> iterator& {
-            --idx_;
+        auto operator--() -> basic_iterator& {
+            advance< -dir >();
             return *this;
         }
-        auto operator--( int ) -> iterator {
+        auto operator--( int ) -> basic_iterator {
             auto const ret = *this;
-            --idx_;
+            advance< -dir >();
             return ret;
         }
 
         [[nodiscard]] auto operator*() -> reference {
-            return range_[ idx_ ];
+            if constexpr ( std::is_integral_v< ty_t > ) {
+                if constexpr ( checked_access ) {
+                    // @requires: dereferenceable iterator, checked as operator[] checks
+                    static_cast< void >( range_[ idx_ ] );
+                }
+                return value_;
+            }
+            else {
+                return range_[ idx_ ];
+            }
         }
         [[nodiscard]] auto operator->() -> pointer {
             return &range_[ idx_ ];
         }
 
     private:
-        range< ty_t > const& range_{};
+        template < std::ptrdiff_t by >
+        void advance() {
+            idx_ += by;
+            if constexpr ( std::is_integral_v< ty_t > ) {
+                if constexpr ( by > 0 && dir > 0 && std::is_signed_v< ty_t > ) {
+                    if ( range_.step_ == ty_t{ 1 } || range_.step_ == ty_t{ -1 } ) {
+                        // a unit step towards stop reaches stop at most, which is representable,
+                        // so the signed add the compiler widens like a raw loop's never overflows
+                        value_ += range_.step_;
+                        return;
+                    }
+                }
+                // modular arithmetic in the unsigned type, stepping past an end at the type's limit
+                // wraps instead of overflowing
+                using counter_t = std::make_unsigned_t< ty_t >;
+                auto const step = static_cast< counter_t >( range_.step_ );
+                value_ = static_cast< ty_t >( static_cast< counter_t >( static_cast< counter_t >( value_ ) + ( by > 0 ? step : static_cast< counter_t >( 0 - step ) ) ) );
+            }
+        }
+
+        range const& range_{};
         std::ptrdiff_t idx_{};
+        ty_t value_{};
     };
-    using reverse_iterator = std::reverse_iterator< iterator >;
+    using iterator = basic_iterator< 1 >;
+    using reverse_iterator = basic_iterator< -1 >;
 
     [[nodiscard]] auto begin() const -> iterator {
         return iterator{ *this, 0 };
     }
     [[nodiscard]] auto end() const -> iterator {
-        return iterator{ *this, gsl::narrow< std::ptrdiff_t >( size() ) };
+        return iterator{ *this, gsl::narrow< std::ptrdiff_t, access_policy >( size() ) };
     }
     [[nodiscard]] auto rbegin() const -> reverse_iterator {
-        return reverse_iterator{ end() };
+        return reverse_iterator{ *this, gsl::narrow< std::ptrdiff_t, access_policy >( size() ) - 1 };
     }
     [[nodiscard]] auto rend() const -> reverse_iterator {
-        return reverse_iterator{ begin() };
+        return reverse_iterator{ *this, -1 };   // one before the first element, never dereferenced
     }
 
 private:
+    [[nodiscard]] constexpr auto negated_step() const -> ty_t
+    {   // @return -step_ for running an integral range backwards, the type's maximum for its minimum
+        return step_ == std::numeric_limits< ty_t >::lowest() ? std::numeric_limits< ty_t >::max() : static_cast< ty_t >( 0 - step_ );
+    }
+    [[nodiscard]] constexpr auto before_start() const -> ty_t
+    {   // @return an exclusive stop one step before start_ for running an integral range backwards,
+        // start_ - step_ clamped to the type's limit when it overflows
+        constexpr auto lowest = std::numeric_limits< ty_t >::lowest();
+        constexpr auto highest = std::numeric_limits< ty_t >::max();
+        if ( step_ > 0 ? start_ < lowest + step_ : start_ > highest + step_ ) {
+            return step_ > 0 ? lowest : highest;
+        }
+        return static_cast< ty_t >( start_ - step_ );
+    }
+    [[nodiscard]] constexpr auto element( std::ptrdiff_t const idx ) const -> ty_t
+    {   // @return the value at 'idx' without checks, modular for integral types so one past
+        // either end computes ( an unused value ) without overflow
+        if constexpr ( std::is_integral_v< ty_t > ) {
+            return static_cast< ty_t >( static_cast< std::uint64_t >( start_ ) +
+                                        static_cast< std::uint64_t >( step_ ) * static_cast< std::uint64_t >( idx ) );
+        }
+        else {
+            return ty_t{};
+        }
+    }
+
     ty_t start_{};
     ty_t stop_{};
     ty_t step_{};
@@ -176,12 +757,235 @@ private:
 template < typename ty_t, typename = std::enable_if_t< std::is_enum_v< ty_t > > >
 range( ty_t const& ) -> range< std::underlying_type_t< ty_t > >;
 
+namespace detail
+{
+    [[nodiscard]] constexpr auto gcd( std::uint64_t a, std::uint64_t b ) -> std::uint64_t
+    {
+        while ( b != 0 ) {
+            auto const t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    [[nodiscard]] constexpr auto mul_mod( std::uint64_t a, std::uint64_t b, std::uint64_t const m ) -> std::uint64_t
+    {   // @return a * b mod m without overflow, by doubling
+        // @requires: a, b < m
+        auto ret = std::uint64_t{ 0 };
+        while ( b != 0 ) {
+            if ( ( b & 1 ) != 0 ) {
+                ret = ret >= m - a ? ret - ( m - a ) : ret + a;
+            }
+            a = a >= m - a ? a - ( m - a ) : a + a;
+            b >>= 1;
+        }
+        return ret;
+    }
+
+    [[nodiscard]] constexpr auto inverse_mod( std::uint64_t const a, std::uint64_t const m ) -> std::uint64_t
+    {   // @return x with a * x == 1 mod m, extended euclid with the coefficients kept mod m
+        // @requires: a < m, gcd( a, m ) == 1
+        auto r0 = m;
+        auto r1 = a;
+        auto x0 = std::uint64_t{ 0 };
+        auto x1 = std::uint64_t{ 1 } % m;
+        while ( r1 != 0 ) {
+            auto const q = r0 / r1;
+            auto const r2 = r0 - q * r1;
+            auto const p = mul_mod( q % m, x1, m );
+            auto const x2 = x0 >= p ? x0 - p : x0 + ( m - p );
+            r0 = r1;
+            r1 = r2;
+            x0 = x1;
+            x1 = x2;
+        }
+        return x0;
+    }
+} // detail
+
+// @utility: values common to two integral ranges, as a range
+template < typename ty_t, typename policy_t >
+[[nodiscard]] constexpr auto intersect( range< ty_t, policy_t > const& a, range< ty_t, policy_t > const& b ) -> range< ty_t, policy_t >
+{   // @return progression of values in both 'a' and 'b', stepping in the direction of 'a'
+    //         with step lcm( |a.step|, |b.step| ); an empty range if there are none
+    // @requires: an lcm the type can hold when two or more values are common, saturating keeps
+    //            the first of them
+    // @example: intersect( range{ 0, 100, 6 }, range{ 4, 100, 10 } ) -> 24, 54, 84
+    // @note: solved with the chinese remainder theorem in O(log step), no iteration. values are
+    //        offsets from the type's lowest value in std::uint64_t, ordered as the values and exact
+    //        for every integral type up to 64 bits
+    static_assert( std::is_integral_v< ty_t > && sizeof( ty_t ) <= sizeof( std::uint64_t ), "intersect requires an integral range of at most 64 bits" );
+    using range_t = range< ty_t, policy_t >;
+    auto const none = range_t{ a.start(), a.start(), a.step() };
+    if ( a.empty() || b.empty() ) {
+        return none;
+    }
+    constexpr auto base = static_cast< std::uint64_t >( std::numeric_limits< ty_t >::lowest() );
+    auto const ascending = []( range_t const& r ) {
+        struct { std::uint64_t lo, hi, step; } ret{ static_cast< std::uint64_t >( r[ 0 ] ) - base,
+                                                    static_cast< std::uint64_t >( r[ -1 ] ) - base,
+                                                    static_cast< std::uint64_t >( detail::abs_diff( r.step(), ty_t{ 0 } ) ) };
+        if ( !( r.step() > ty_t{ 0 } ) ) {
+            ret = { ret.hi, ret.lo, ret.step };
+        }
+        return ret;
+    };
+    auto const ra = ascending( a );
+    auto const rb = ascending( b );
+    auto const lo = ra.lo > rb.lo ? ra.lo : rb.lo;
+    auto const hi = ra.hi < rb.hi ? ra.hi : rb.hi;
+    auto const g = detail::gcd( ra.step, rb.step );
+    auto const diff = rb.lo > ra.lo ? rb.lo - ra.lo : ra.lo - rb.lo;
+    if ( lo > hi || diff % g != 0 ) {
+        return none;
+    }
+    // a's values are ra.lo + ra.step * j, common ones have j == t mod m for
+    // t == ( rb.lo - ra.lo ) / g * inv( ra.step / g ) mod m
+    auto const m = rb.step / g;
+    auto d = ( diff / g ) % m;
+    d = rb.lo > ra.lo || d == 0 ? d : m - d;
+    auto const t = detail::mul_mod( d, detail::inverse_mod( ( ra.step / g ) % m, m ), m );
+    // first index j0 of a value >= lo and last j1 of one <= hi, then the first common index
+    auto const j0 = ( lo - ra.lo ) / ra.step + ( ( lo - ra.lo ) % ra.step != 0 ? 1 : 0 );
+    auto const j1 = ( hi - ra.lo ) / ra.step;
+    auto const r = j0 % m;
+    auto const skip = t >= r ? t - r : t + ( m - r );
+    if ( j0 > j1 || skip > j1 - j0 ) {
+        return none;
+    }
+    auto const j = j0 + skip;
+    auto const value = [&]( std::uint64_t const k ) { return static_cast< ty_t >( ra.lo + ra.step * k + base ); };
+    auto const first = value( j );
+    // every common value is a value of 'a', so one step past them in the direction of 'a' does not overflow
+    auto const only = [&]( ty_t const v ) {
+        return a.step() > ty_t{ 0 } ? range_t{ v, static_cast< ty_t >( v + 1 ), a.step() } : range_t{ v, static_cast< ty_t >( v - 1 ), a.step() };
+    };
+    auto const more = ( j1 - j ) / m;
+    if ( more == 0 ) {
+        return only( first );
+    }
+    // the common values span ra.step * m * more <= hi - lo, so the lcm fits std::uint64_t
+    auto const l = ra.step * m;
+    auto const fits = l <= static_cast< std::uint64_t >( std::numeric_limits< ty_t >::max() );
+    detail::require< policy_t, invalid_range_error >( fits, "intersection step is not representable" );
+    if ( !fits ) {
+        return only( a.step() > ty_t{ 0 } ? first : value( j + more * m ) );
+    }
+    auto const last = value( j + more * m );
+    return a.step() > ty_t{ 0 }
+        ? range_t{ first, static_cast< ty_t >( last + 1 ), static_cast< ty_t >( l ) }
+        : range_t{ last, static_cast< ty_t >( first - 1 ), static_cast< ty_t >( std::uint64_t{ 0 } - l ) };
+}
+
+namespace detail
+{
+#if defined( __SIZEOF_INT128__ )
+    // __extension__ keeps -Wpedantic quiet about the compiler's 128 bit integer
+    __extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+    [[nodiscard]] constexpr auto mulhi64( std::uint64_t const a, std::uint64_t const b ) -> std::uint64_t
+    {   // @return high 64 bits of the 128 bit product a * b
+#if defined( __SIZEOF_INT128__ )
+        return static_cast< std::uint64_t >( ( static_cast< uint128_t >( a ) * b ) >> 64 );
+#else
+        auto const lo_mask = std::uint64_t{ 0xffffffff };
+        auto const ll = ( a & lo_mask ) * ( b & lo_mask );
+        auto const lh = ( a & lo_mask ) * ( b >> 32 );
+        auto const hl = ( a >> 32 ) * ( b & lo_mask );
+        auto const mid = ( ll >> 32 ) + ( lh & lo_mask ) + ( hl & lo_mask );
+        return ( a >> 32 ) * ( b >> 32 ) + ( lh >> 32 ) + ( hl >> 32 ) + ( mid >> 32 );
+#endif
+    }
+} // detail
+
+// @utility: integral step with its division precomputed, for a stride reused across many ranges
+// unit and power of two steps shift, any other step multiplies by a reciprocal computed once
+// ( granlund-montgomery round-up method, as used by libdivide ), so size() and index_of()
+// avoid a hardware division per call
+template < typename ty_t >
+class precomputed_step
+{
+    static_assert( std::is_integral_v< ty_t >, "precomputed_step requires an integral step" );
+
+public:
+    constexpr explicit precomputed_step( ty_t const& step ) :
+        step_{ step },
+        stride_{ static_cast< std::uint64_t >( detail::abs_diff( step, ty_t{ 0 } ) ) }
+    {   // @example: precomputed_step{ 7 }.size( range{ 0, 100, 7 } ) == 15
+        // @requires: non-zero step size
+        assert( step != ty_t{ 0 } );
+        auto log2 = 0;   // ceil( log2( stride ) )
+        while ( log2 < 64 && ( ( stride_ - 1 ) >> log2 ) != 0 ) {
+            ++log2;
+        }
+        if ( ( stride_ & ( stride_ - 1 ) ) == 0 ) {
+            shift_ = log2;
+            return;
+        }
+        // magic = floor( 2^64 * ( 2^log2 - stride ) / stride ) + 1, by long division
+        auto r = ( log2 == 64 ? std::uint64_t{ 0 } : std::uint64_t{ 1 } << log2 ) - stride_;
+        auto q = std::uint64_t{ 0 };
+        for ( auto i = 0; i < 64; ++i ) {
+            auto const carry = ( r >> 63 ) != 0;
+            r <<= 1;
+            q <<= 1;
+            if ( carry || r >= stride_ ) {
+                r -= stride_;
+                q |= 1;
+            }
+        }
+        magic_ = q + 1;
+        shift_ = log2 - 1;
+    }
+
+    [[nodiscard]] constexpr auto step() const -> ty_t
+    {
+        return step_;
+    }
+    [[nodiscard]] constexpr auto divide( std::uint64_t const n ) const -> std::uint64_t
+    {   // @return n / | step |
+        if ( magic_ == 0 ) {
+            return n >> shift_;
+        }
+        auto const t = detail::mulhi64( magic_, n );
+        return ( t + ( ( n - t ) >> 1 ) ) >> shift_;
+    }
+    [[nodiscard]] constexpr auto size( range< ty_t > const& r ) const -> std::size_t
+    {   // @return r.size()
+        // @requires: range with this step
+        assert( r.step() == step_ );
+        auto const dist = static_cast< std::uint64_t >( detail::abs_diff( r.start(), r.stop() ) );
+        auto const q = divide( dist );
+        return static_cast< std::size_t >( q * stride_ == dist ? q : q + 1 );
+    }
+    [[nodiscard]] constexpr auto index_of( range< ty_t > const& r, ty_t const& v ) const -> std::ptrdiff_t
+    {   // @return r.index_of( v )
+        // @requires: range with this step
+        assert( r.step() == step_ );
+        auto const up = step_ > ty_t{ 0 };
+        if ( up ? ( v < r.start() || v >= r.stop() ) : ( v > r.start() || v <= r.stop() ) ) {
+            return -1;
+        }
+        auto const dist = static_cast< std::uint64_t >( detail::abs_diff( v, r.start() ) );
+        auto const q = divide( dist );
+        return q * stride_ == dist ? static_cast< std::ptrdiff_t >( q ) : -1;
+    }
+
+private:
+    ty_t step_{};
+    std::uint64_t stride_{};
+    std::uint64_t magic_{};   // 0 for power of two strides
+    int shift_{};
+};
+
 // @utility: min range of container.size() or count
 template < typename ty_t, typename con_t >
 inline auto min_range( con_t const& c, ty_t const& count )
 {
     auto const sz = gsl::narrow< ty_t >( c.size() );
-    return range{ std::min( sz, count ) };
+    return range{ sz < count ? sz : count };
 }
 
 } // roam
@@ -0,0 +1,379 @@
+// range_adaptors.h
+//
+// lazy, pipe-able adaptors over roam::range and each other
+// transform, reverse, stride, take and drop keep size() and O(1) operator[] so the
+// result can still be split across threads or lanes; filter keeps forward iteration only
+// e.g.
+//     auto const sq = roam::range{ 10 } | roam::transform( []( int i ) { return i * i; } );
+//     for ( auto const v : roam::range{ 100 } | roam::stride( 3 ) | roam::reverse() ) {}
+//     for ( auto const v : roam::range{ 100 } | roam::filter( is_prime ) ) {}
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_ADAPTORS_H_
+#define _INC_ROAM_RANGE_ADAPTORS_H_
+
+#include "range.h"
+
+#include <utility>
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+namespace detail
+{
+    // base class of the pipe-able adaptor objects, adaptor( base ) builds the view
+    struct adaptor_tag
+    {
+    };
+
+    template < typename ty_t >
+    inline auto constexpr is_adaptor_v = std::is_base_of_v< adaptor_tag, std::decay_t< ty_t > >;
+
+    template < typename base_t >
+    [[nodiscard]] constexpr auto ssize( base_t const& base ) -> std::ptrdiff_t
+    {
+        return static_cast< std::ptrdiff_t >( base.size() );
+    }
+} // detail
+
+// random access views
+// each holds its base by value ( ranges and views are a few words ), operator[] accepts
+// negative indices like range and always passes non-negative indices to the base
+
+template < typename base_t, typename fn_t >
+class transform_view
+{
+public:
+    using value_type = std::decay_t< std::invoke_result_t< fn_t const&, typename base_t::value_type > >;
+
+    constexpr explicit transform_view( base_t const& base, fn_t const& fn ) :
+        base_{ base },
+        fn_{ fn }
+    {
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return base_.size();
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return 0 == size();
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx ) const -> value_type
+    {
+        return fn_( base_[ idx >= 0 ? idx : detail::ssize( *this ) + idx ] );
+    }
+
+    using iterator = detail::index_iterator< transform_view >;
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, detail::ssize( *this ) };
+    }
+
+private:
+    base_t base_;
+    fn_t fn_;
+};
+
+template < typename base_t >
+class reverse_view
+{
+public:
+    using value_type = typename base_t::value_type;
+
+    constexpr explicit reverse_view( base_t const& base ) :
+        base_{ base }
+    {
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return base_.size();
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return 0 == size();
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx ) const -> value_type
+    {
+        auto const n = detail::ssize( base_ );
+        return base_[ idx >= 0 ? n - 1 - idx : -1 - idx ];
+    }
+
+    using iterator = detail::index_iterator< reverse_view >;
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, detail::ssize( *this ) };
+    }
+
+private:
+    base_t base_;
+};
+
+template < typename base_t >
+class stride_view
+{
+public:
+    using value_type = typename base_t::value_type;
+
+    constexpr explicit stride_view( base_t const& base, std::ptrdiff_t const stride ) :
+        base_{ base },
+        stride_{ stride }
+    {   // @requires: positive stride
+        assert( stride_ > 0 );
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {   // @return ceil( base.size() / stride )
+        return static_cast< std::size_t >( ( detail::ssize( base_ ) + stride_ - 1 ) / stride_ );
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return 0 == size();
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx ) const -> value_type
+    {
+        return base_[ ( idx >= 0 ? idx : detail::ssize( *this ) + idx ) * stride_ ];
+    }
+
+    using iterator = detail::index_iterator< stride_view >;
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, detail::ssize( *this ) };
+    }
+
+private:
+    base_t base_;
+    std::ptrdiff_t stride_{};
+};
+
+// take ( offset == 0 ) and drop ( count == base size - n ) are both a contiguous window
+template < typename base_t >
+class window_view
+{
+public:
+    using value_type = typename base_t::value_type;
+
+    constexpr explicit window_view( base_t const& base, std::ptrdiff_t const offset, std::ptrdiff_t const count ) :
+        base_{ base },
+        offset_{ offset },
+        count_{ count }
+    {   // @requires: window inside base
+        assert( 0 <= offset_ && 0 <= count_ && offset_ + count_ <= detail::ssize( base_ ) );
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return static_cast< std::size_t >( count_ );
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return 0 == count_;
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx ) const -> value_type
+    {
+        // @requires: valid index
+        assert( -count_ <= idx && idx < count_ );
+        return base_[ offset_ + ( idx >= 0 ? idx : count_ + idx ) ];
+    }
+
+    using iterator = detail::index_iterator< window_view >;
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, count_ };
+    }
+
+private:
+    base_t base_;
+    std::ptrdiff_t offset_{};
+    std::ptrdiff_t count_{};
+};
+
+// forward only view, the number of matches is unknown until iterated
+template < typename base_t, typename pred_t >
+class filter_view
+{
+public:
+    using value_type = typename base_t::value_type;
+
+    constexpr explicit filter_view( base_t const& base, pred_t const& pred ) :
+        base_{ base },
+        pred_{ pred }
+    {
+    }
+
+    class iterator
+    {   // iterator holds reference to filter_view and is invalidated if it is destroyed
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = typename base_t::value_type;
+        using reference = value_type;
+        using pointer = value_type*;
+        using iterator_category = std::forward_iterator_tag;
+
+        explicit iterator( filter_view const& view, std::ptrdiff_t const& idx ) :
+            view_{ view },
+            idx_{ idx }
+        {
+            skip();
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return &view_ == &rhs.view_ && idx_ == rhs.idx_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            ++idx_;
+            skip();
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() const -> reference {
+            return view_.base_[ idx_ ];
+        }
+
+    private:
+        void skip()
+        {   // advance to the next match or end
+            auto const n = detail::ssize( view_.base_ );
+            while ( idx_ < n && !view_.pred_( view_.base_[ idx_ ] ) ) {
+                ++idx_;
+            }
+        }
+
+        filter_view const& view_;
+        std::ptrdiff_t idx_{};
+    };
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, detail::ssize( base_ ) };
+    }
+
+private:
+    base_t base_;
+    pred_t pred_;
+};
+
+// adaptor objects
+
+template < typename fn_t >
+struct transform : detail::adaptor_tag
+{
+    constexpr explicit transform( fn_t const& f ) :
+        fn{ f }
+    {   // @example: range{ 5 } | transform( []( int i ) { return 2 * i; } )
+    }
+    template < typename base_t >
+    [[nodiscard]] constexpr auto operator()( base_t const& base ) const
+    {
+        return transform_view< base_t, fn_t >{ base, fn };
+    }
+    fn_t fn;
+};
+
+struct reverse : detail::adaptor_tag
+{   // @example: range{ 5 } | reverse() -> 4, 3, 2, 1, 0
+    template < typename base_t >
+    [[nodiscard]] constexpr auto operator()( base_t const& base ) const
+    {
+        return reverse_view< base_t >{ base };
+    }
+};
+
+struct stride : detail::adaptor_tag
+{
+    constexpr explicit stride( std::ptrdiff_t const count ) :
+        n{ count }
+    {   // @example: range{ 10 } | stride( 3 ) -> 0, 3, 6, 9
+    }
+    template < typename base_t >
+    [[nodiscard]] constexpr auto operator()( base_t const& base ) const
+    {
+        return stride_view< base_t >{ base, n };
+    }
+    std::ptrdiff_t n{};
+};
+
+struct take : detail::adaptor_tag
+{
+    constexpr explicit take( std::ptrdiff_t const count ) :
+        n{ count }
+    {   // @example: range{ 10 } | take( 3 ) -> 0, 1, 2
+    }
+    template < typename base_t >
+    [[nodiscard]] constexpr auto operator()( base_t const& base ) const
+    {
+        auto const sz = detail::ssize( base );
+        return window_view< base_t >{ base, 0, n < sz ? n : sz };
+    }
+    std::ptrdiff_t n{};
+};
+
+struct drop : detail::adaptor_tag
+{
+    constexpr explicit drop( std::ptrdiff_t const count ) :
+        n{ count }
+    {   // @example: range{ 10 } | drop( 7 ) -> 7, 8, 9
+    }
+    template < typename base_t >
+    [[nodiscard]] constexpr auto operator()( base_t const& base ) const
+    {
+        auto const sz = detail::ssize( base );
+        auto const offset = n < sz ? n : sz;
+        return window_view< base_t >{ base, offset, sz - offset };
+    }
+    std::ptrdiff_t n{};
+};
+
+template < typename pred_t >
+struct filter : detail::adaptor_tag
+{
+    constexpr explicit filter( pred_t const& p ) :
+        pred{ p }
+    {   // @example: range{ 10 } | filter( []( int i ) { return i % 3 == 0; } ) -> 0, 3, 6, 9
+    }
+    template < typename base_t >
+    [[nodiscard]] constexpr auto operator()( base_t const& base ) const
+    {
+        return filter_view< base_t, pred_t >{ base, pred };
+    }
+    pred_t pred;
+};
+
+template < typename base_t, typename adaptor_t, typename = std::enable_if_t< detail::is_adaptor_v< adaptor_t > > >
+[[nodiscard]] constexpr auto operator|( base_t const& base, adaptor_t const& adaptor )
+{   // @return view of 'base' through 'adaptor'
+    return adaptor( base );
+}
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_ADAPTORS_H_
@@ -0,0 +1,798 @@
+// range_bitmap.h
+//
+// compressed bitmap of 32 bit indices ( roaring layout )
+// the index space is cut into 65536 value chunks, each stored as whichever is smallest:
+//     array  - sorted 16 bit values            ( sparse, <= 4096 values )
+//     bitmap - 1024 64 bit words               ( dense )
+//     run    - [ first, last ] 16 bit pairs    ( clustered )
+// built in bulk from roam::range inputs and read back as runs of ranges
+// e.g.
+//     auto b = roam::index_bitmap{};
+//     b.add( roam::range< uint32_t >{ 1000, 2000000 } );
+//     b.add( roam::range< uint32_t >{ 0, 100000000, 97 } );
+//     auto const both = b & other;
+//     for ( auto const r : both.runs() ) {}        // roam::range< int64_t >
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_BITMAP_H_
+#define _INC_ROAM_RANGE_BITMAP_H_
+
+#include "range.h"
+
+#include <algorithm>   // for lower_bound / set operations
+#include <cstdint>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+namespace detail
+{
+    [[nodiscard]] inline auto popcount64( std::uint64_t const x ) -> std::uint32_t
+    {
+#if defined( __GNUC__ ) || defined( __clang__ )
+        return static_cast< std::uint32_t >( __builtin_popcountll( x ) );
+#else
+        auto v = x - ( ( x >> 1 ) & 0x5555555555555555ull );
+        v = ( v & 0x3333333333333333ull ) + ( ( v >> 2 ) & 0x3333333333333333ull );
+        v = ( v + ( v >> 4 ) ) & 0x0f0f0f0f0f0f0f0full;
+        return static_cast< std::uint32_t >( ( v * 0x0101010101010101ull ) >> 56 );
+#endif
+    }
+
+    [[nodiscard]] inline auto ctz64( std::uint64_t const x ) -> std::uint32_t
+    {   // @requires: non-zero input
+        assert( x != 0 );
+#if defined( __GNUC__ ) || defined( __clang__ )
+        return static_cast< std::uint32_t >( __builtin_ctzll( x ) );
+#else
+        auto n = std::uint32_t{ 0 };
+        while ( ( ( x >> n ) & 1 ) == 0 ) {
+            ++n;
+        }
+        return n;
+#endif
+    }
+} // detail
+
+class index_bitmap
+{
+public:
+    using value_type = std::uint32_t;
+
+    index_bitmap() = default;
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {   // @return number of indices, O(chunks)
+        auto ret = std::size_t{ 0 };
+        for ( auto const& ch : chunks_ ) {
+            ret += ch.c.card;
+        }
+        return ret;
+    }
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return chunks_.empty();
+    }
+    [[nodiscard]] auto bytes() const -> std::size_t
+    {   // @return heap bytes held by the containers
+        auto ret = chunks_.capacity() * sizeof( chunk );
+        for ( auto const& ch : chunks_ ) {
+            ret += ch.c.values.capacity() * sizeof( std::uint16_t ) + ch.c.words.capacity() * sizeof( std::uint64_t );
+        }
+        return ret;
+    }
+    [[nodiscard]] auto contains( std::uint32_t const v ) const -> bool
+    {
+        auto const* ch = find( high( v ) );
+        return ch != nullptr && contains( ch->c, low( v ) );
+    }
+
+    void add( std::uint32_t const v )
+    {
+        add( chunk_for( high( v ) ), low( v ) );
+    }
+    void remove( std::uint32_t const v )
+    {
+        auto* ch = find( high( v ) );
+        if ( ch != nullptr ) {
+            remove( ch->c, low( v ) );
+            if ( ch->c.card == 0 ) {
+                chunks_.erase( chunks_.begin() + ( ch - chunks_.data() ) );
+            }
+        }
+    }
+    template < typename ty_t >
+    void add( range< ty_t > const& r )
+    {   // add every value of 'r' a chunk at a time, unit steps as runs, other steps in ascending
+        // order whatever the step's sign
+        // @requires: values fit in 32 bits unsigned
+        static_assert( std::is_integral_v< ty_t >, "index_bitmap holds integral indices" );
+        if ( r.empty() ) {
+            return;
+        }
+        auto const first = static_cast< std::int64_t >( r[ 0 ] );
+        auto const last = static_cast< std::int64_t >( r[ -1 ] );
+        assert( first >= 0 && last >= 0 && first <= UINT32_MAX && last <= UINT32_MAX );
+        if ( r.step() == ty_t{ 1 } ) {
+            add_interval( static_cast< std::uint64_t >( first ), static_cast< std::uint64_t >( last ) + 1 );
+        }
+        else if ( std::is_signed_v< ty_t > && r.step() == static_cast< ty_t >( -1 ) ) {
+            add_interval( static_cast< std::uint64_t >( last ), static_cast< std::uint64_t >( first ) + 1 );
+        }
+        else {
+            add_stepped( static_cast< std::uint64_t >( first < last ? first : last ), static_cast< std::uint64_t >( first < last ? last : first ),
+                         static_cast< std::uint64_t >( detail::abs_diff( r.step(), ty_t{ 0 } ) ) );
+        }
+    }
+
+    void optimize()
+    {   // re-pick the smallest container for every chunk, e.g. after many single adds
+        for ( auto& ch : chunks_ ) {
+            ch.c = from_words( to_words( ch.c ) );
+        }
+    }
+
+    // runs
+    template < typename fn_t >
+    void for_each_run( fn_t&& fn ) const
+    {   // invoke fn( range< int64_t > ) for every maximal run of consecutive indices
+        auto lo = std::int64_t{ -1 };
+        auto hi = std::int64_t{ -1 };
+        for ( auto const& ch : chunks_ ) {
+            auto const base = static_cast< std::int64_t >( ch.key ) << 16;
+            for_each_run( ch.c, [&]( std::uint32_t const a, std::uint32_t const b ) {
+                if ( base + a == hi ) {   // continues across the chunk boundary
+                    hi = base + b;
+                    return;
+                }
+                if ( hi >= 0 ) {
+                    fn( range< std::int64_t >{ lo, hi } );
+                }
+                lo = base + a;
+                hi = base + b;
+            } );
+        }
+        if ( hi >= 0 ) {
+            fn( range< std::int64_t >{ lo, hi } );
+        }
+    }
+    [[nodiscard]] auto runs() const -> std::vector< range< std::int64_t > >
+    {   // @return maximal runs of consecutive indices, ascending
+        auto ret = std::vector< range< std::int64_t > >{};
+        for_each_run( [&]( range< std::int64_t > const& r ) { ret.push_back( r ); } );
+        return ret;
+    }
+
+    // set algebra, chunk by chunk; array and run containers merge without a bitmap, bitmap x
+    // bitmap is a straight word loop the compiler vectorizes
+    [[nodiscard]] friend auto operator|( index_bitmap const& a, index_bitmap const& b ) -> index_bitmap
+    {
+        return combine( a, b, op::or_ );
+    }
+    [[nodiscard]] friend auto operator&( index_bitmap const& a, index_bitmap const& b ) -> index_bitmap
+    {
+        return combine( a, b, op::and_ );
+    }
+    [[nodiscard]] friend auto operator-( index_bitmap const& a, index_bitmap const& b ) -> index_bitmap
+    {   // and not
+        return combine( a, b, op::andnot );
+    }
+    auto operator|=( index_bitmap const& rhs ) -> index_bitmap& {
+        return *this = *this | rhs;
+    }
+    auto operator&=( index_bitmap const& rhs ) -> index_bitmap& {
+        return *this = *this & rhs;
+    }
+    auto operator-=( index_bitmap const& rhs ) -> index_bitmap& {
+        return *this = *this - rhs;
+    }
+    [[nodiscard]] friend auto operator==( index_bitmap const& a, index_bitmap const& b ) -> bool
+    {   // same indices, regardless of container choice
+        if ( a.chunks_.size() != b.chunks_.size() ) {
+            return false;
+        }
+        for ( auto const i : range{ a.chunks_.size() } ) {
+            auto const& x = a.chunks_[ i ];
+            auto const& y = b.chunks_[ i ];
+            if ( x.key != y.key || !equal( x.c, y.c ) ) {
+                return false;
+            }
+        }
+        return true;
+    }
+    [[nodiscard]] friend auto operator!=( index_bitmap const& a, index_bitmap const& b ) -> bool
+    {
+        return !( a == b );
+    }
+
+    // iteration over the indices in ascending order
+    class iterator
+    {   // iterator holds reference to index_bitmap and is invalidated if it is modified
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::uint32_t;
+        using reference = std::uint32_t;
+        using pointer = std::uint32_t*;
+        using iterator_category = std::forward_iterator_tag;
+
+        explicit iterator( index_bitmap const& bitmap, std::size_t const chunk ) :
+            bitmap_{ bitmap },
+            chunk_{ chunk }
+        {
+            seek( 0 );
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return &bitmap_ == &rhs.bitmap_ && chunk_ == rhs.chunk_ && value_ == rhs.value_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            seek( ( value_ & 0xffff ) + 1 );
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() const -> reference {
+            return value_;
+        }
+
+    private:
+        void seek( std::uint32_t from )
+        {   // move to the first index >= 'from' in the current chunk or the next non-empty one
+            auto const& chunks = bitmap_.chunks_;
+            for ( ; chunk_ < chunks.size(); ++chunk_, from = 0 ) {
+                auto const next = from < chunk_bits ? next_value( chunks[ chunk_ ].c, from ) : chunk_bits;
+                if ( next < chunk_bits ) {
+                    value_ = ( static_cast< std::uint32_t >( chunks[ chunk_ ].key ) << 16 ) | next;
+                    return;
+                }
+            }
+            value_ = 0;
+        }
+
+        index_bitmap const& bitmap_;
+        std::size_t chunk_{};
+        std::uint32_t value_{};
+    };
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, chunks_.size() };
+    }
+
+private:
+    static auto constexpr chunk_bits = std::uint32_t{ 65536 };
+    static auto constexpr chunk_words = std::size_t{ 1024 };
+    static auto constexpr array_max = std::uint32_t{ 4096 };
+
+    enum class op { or_, and_, andnot };
+
+    struct container
+    {
+        enum class kind : std::uint8_t { array, bitmap, run };
+
+        kind type{ kind::array };
+        std::uint32_t card{};
+        std::vector< std::uint16_t > values;   // array: sorted values, run: [ first, last ] pairs
+        std::vector< std::uint64_t > words;    // bitmap: chunk_words words
+    };
+    struct chunk
+    {
+        std::uint16_t key{};
+        container c;
+    };
+
+    [[nodiscard]] static auto high( std::uint32_t const v ) -> std::uint16_t
+    {
+        return static_cast< std::uint16_t >( v >> 16 );
+    }
+    [[nodiscard]] static auto low( std::uint32_t const v ) -> std::uint16_t
+    {
+        return static_cast< std::uint16_t >( v & 0xffff );
+    }
+
+    [[nodiscard]] auto find( std::uint16_t const key ) const -> chunk const*
+    {
+        auto const it = std::lower_bound( chunks_.begin(), chunks_.end(), key, []( chunk const& ch, std::uint16_t const k ) { return ch.key < k; } );
+        return it != chunks_.end() && it->key == key ? &*it : nullptr;
+    }
+    [[nodiscard]] auto find( std::uint16_t const key ) -> chunk*
+    {
+        return const_cast< chunk* >( static_cast< index_bitmap const& >( *this ).find( key ) );
+    }
+    [[nodiscard]] auto chunk_for( std::uint16_t const key ) -> container&
+    {   // @return container of 'key', inserted empty if missing
+        auto const it = std::lower_bound( chunks_.begin(), chunks_.end(), key, []( chunk const& ch, std::uint16_t const k ) { return ch.key < k; } );
+        if ( it != chunks_.end() && it->key == key ) {
+            return it->c;
+        }
+        return chunks_.insert( it, chunk{ key, container{} } )->c;
+    }
+
+    void add_interval( std::uint64_t const lo, std::uint64_t const hi )
+    {   // add [lo, hi), one run container per chunk touched
+        for ( auto key = lo >> 16; key <= ( hi - 1 ) >> 16; ++key ) {
+            auto const base = key << 16;
+            auto const a = static_cast< std::uint32_t >( ( lo > base ? lo : base ) - base );
+            auto const b = static_cast< std::uint32_t >( ( hi < base + chunk_bits ? hi : base + chunk_bits ) - base );
+            auto piece = container{ container::kind::run, b - a, { static_cast< std::uint16_t >( a ), static_cast< std::uint16_t >( b - 1 ) }, {} };
+            auto& c = chunk_for( static_cast< std::uint16_t >( key ) );
+            c = c.card == 0 ? std::move( piece ) : combine( c, piece, op::or_ );
+        }
+    }
+
+    void add_stepped( std::uint64_t const lo, std::uint64_t const hi, std::uint64_t const stride )
+    {   // add lo, lo + stride, ... <= hi, one array or bitmap container per chunk touched
+        for ( auto v = lo; v <= hi; ) {
+            auto const key = v >> 16;
+            auto const chunk_last = ( key << 16 ) + ( chunk_bits - 1 );
+            auto const count = ( ( hi < chunk_last ? hi : chunk_last ) - v ) / stride + 1;
+            auto piece = container{};
+            piece.card = static_cast< std::uint32_t >( count );
+            if ( count <= array_max ) {
+                piece.values.reserve( count );
+                for ( auto k = std::uint64_t{ 0 }; k < count; ++k ) {
+                    piece.values.push_back( static_cast< std::uint16_t >( v + k * stride ) );
+                }
+            }
+            else {
+                piece.type = container::kind::bitmap;
+                piece.words.resize( chunk_words );
+                for ( auto k = std::uint64_t{ 0 }; k < count; ++k ) {
+                    auto const bit = static_cast< std::uint16_t >( v + k * stride );
+                    piece.words[ bit / 64 ] |= std::uint64_t{ 1 } << ( bit % 64 );
+                }
+            }
+            auto& c = chunk_for( static_cast< std::uint16_t >( key ) );
+            c = c.card == 0 ? std::move( piece ) : combine( c, piece, op::or_ );
+            v += count * stride;
+        }
+    }
+
+    // word helpers
+    static void set_bits( std::vector< std::uint64_t >& words, std::uint32_t const lo, std::uint32_t const hi )
+    {   // set bits [lo, hi)
+        if ( lo >= hi ) {
+            return;
+        }
+        auto const first = lo / 64;
+        auto const last = ( hi - 1 ) / 64;
+        auto const head = ~std::uint64_t{ 0 } << ( lo % 64 );
+        auto const tail = ~std::uint64_t{ 0 } >> ( 63 - ( hi - 1 ) % 64 );
+        if ( first == last ) {
+            words[ first ] |= head & tail;
+            return;
+        }
+        words[ first ] |= head;
+        for ( auto i = first + 1; i < last; ++i ) {
+            words[ i ] = ~std::uint64_t{ 0 };
+        }
+        words[ last ] |= tail;
+    }
+    [[nodiscard]] static auto next_bit( std::vector< std::uint64_t > const& words, std::uint32_t const from, bool const set ) -> std::uint32_t
+    {   // @return position of the first bit >= 'from' equal to 'set', chunk_bits if none
+        if ( from >= chunk_bits ) {
+            return chunk_bits;
+        }
+        auto const flip = set ? std::uint64_t{ 0 } : ~std::uint64_t{ 0 };
+        auto i = from / 64;
+        auto w = ( words[ i ] ^ flip ) & ( ~std::uint64_t{ 0 } << ( from % 64 ) );
+        while ( w == 0 ) {
+            if ( ++i == chunk_words ) {
+                return chunk_bits;
+            }
+            w = words[ i ] ^ flip;
+        }
+        return static_cast< std::uint32_t >( i * 64 ) + detail::ctz64( w );
+    }
+
+    // container conversions
+    [[nodiscard]] static auto to_words( container const& c ) -> std::vector< std::uint64_t >
+    {
+        if ( c.type == container::kind::bitmap ) {
+            return c.words;
+        }
+        auto ret = std::vector< std::uint64_t >( chunk_words );
+        if ( c.type == container::kind::array ) {
+            for ( auto const v : c.values ) {
+                ret[ v / 64 ] |= std::uint64_t{ 1 } << ( v % 64 );
+            }
+        }
+        else {
+            for ( auto i = std::size_t{ 0 }; i < c.values.size(); i += 2 ) {
+                set_bits( ret, c.values[ i ], c.values[ i + 1 ] + 1u );
+            }
+        }
+        return ret;
+    }
+    [[nodiscard]] static auto from_words( std::vector< std::uint64_t > words, bool const allow_runs = true ) -> container
+    {   // @return smallest container holding 'words'
+        auto card = std::uint32_t{ 0 };
+        auto runs = std::uint32_t{ 0 };
+        auto carry = std::uint64_t{ 0 };
+        for ( auto const w : words ) {
+            card += detail::popcount64( w );
+            runs += detail::popcount64( w & ~( ( w << 1 ) | carry ) );   // bits that start a run
+            carry = w >> 63;
+        }
+        auto ret = container{};
+        ret.card = card;
+        auto const array_bytes = card <= array_max ? 2 * card : UINT32_MAX;
+        auto const bitmap_bytes = static_cast< std::uint32_t >( chunk_words * sizeof( std::uint64_t ) );
+        if ( allow_runs && 4 * runs < array_bytes && 4 * runs < bitmap_bytes ) {
+            ret.type = container::kind::run;
+            ret.values.reserve( 2 * runs );
+            for ( auto lo = next_bit( words, 0, true ); lo < chunk_bits; ) {
+                auto const hi = next_bit( words, lo, false );
+                ret.values.push_back( static_cast< std::uint16_t >( lo ) );
+                ret.values.push_back( static_cast< std::uint16_t >( hi - 1 ) );
+                lo = next_bit( words, hi, true );
+            }
+        }
+        else if ( array_bytes < bitmap_bytes ) {
+            ret.type = container::kind::array;
+            ret.values.reserve( card );
+            for ( auto i = std::size_t{ 0 }; i < chunk_words; ++i ) {
+                for ( auto w = words[ i ]; w != 0; w &= w - 1 ) {
+                    ret.values.push_back( static_cast< std::uint16_t >( i * 64 + detail::ctz64( w ) ) );
+                }
+            }
+        }
+        else {
+            ret.type = container::kind::bitmap;
+            ret.words = std::move( words );
+        }
+        return ret;
+    }
+    [[nodiscard]] static auto from_runs( container runs ) -> container
+    {   // @return smallest container holding the runs of run container 'runs', without going
+        // through a bitmap unless that is the smallest
+        auto const n = static_cast< std::uint32_t >( runs.values.size() / 2 );
+        auto const array_bytes = runs.card <= array_max ? 2 * runs.card : UINT32_MAX;
+        auto const bitmap_bytes = static_cast< std::uint32_t >( chunk_words * sizeof( std::uint64_t ) );
+        if ( 4 * n < array_bytes && 4 * n < bitmap_bytes ) {
+            return runs;
+        }
+        if ( array_bytes < bitmap_bytes ) {
+            auto ret = container{ container::kind::array, runs.card, {}, {} };
+            ret.values.reserve( runs.card );
+            for ( auto i = std::size_t{ 0 }; i < runs.values.size(); i += 2 ) {
+                for ( auto v = std::uint32_t{ runs.values[ i ] }; v <= runs.values[ i + 1 ]; ++v ) {
+                    ret.values.push_back( static_cast< std::uint16_t >( v ) );
+                }
+            }
+            return ret;
+        }
+        return container{ container::kind::bitmap, runs.card, {}, to_words( runs ) };
+    }
+    static void materialize( container& c )
+    {   // run container to array or bitmap, ahead of single value edits
+        if ( c.type == container::kind::run ) {
+            c = from_words( to_words( c ), false );
+        }
+    }
+
+    // container queries and edits
+    [[nodiscard]] static auto run_index( container const& c, std::uint16_t const v ) -> std::size_t
+    {   // @return index of the first run whose last value >= v
+        auto lo = std::size_t{ 0 };
+        auto hi = c.values.size() / 2;
+        while ( lo < hi ) {
+            auto const mid = ( lo + hi ) / 2;
+            if ( c.values[ 2 * mid + 1 ] < v ) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+    [[nodiscard]] static auto next_value( container const& c, std::uint32_t const from ) -> std::uint32_t
+    {   // @return first value >= 'from', chunk_bits if none
+        switch ( c.type ) {
+        case container::kind::array: {
+            auto const it = std::lower_bound( c.values.begin(), c.values.end(), from );
+            return it != c.values.end() ? *it : chunk_bits;
+        }
+        case container::kind::bitmap:
+            return next_bit( c.words, from, true );
+        case container::kind::run: {
+            auto const r = run_index( c, static_cast< std::uint16_t >( from ) );
+            if ( r == c.values.size() / 2 ) {
+                return chunk_bits;
+            }
+            return c.values[ 2 * r ] > from ? c.values[ 2 * r ] : from;
+        }
+        }
+        return chunk_bits;
+    }
+    [[nodiscard]] static auto contains( container const& c, std::uint16_t const v ) -> bool
+    {
+        return next_value( c, v ) == v;
+    }
+    static void add( container& c, std::uint16_t const v )
+    {
+        materialize( c );
+        if ( c.type == container::kind::bitmap ) {
+            auto& w = c.words[ v / 64 ];
+            auto const bit = std::uint64_t{ 1 } << ( v % 64 );
+            c.card += ( w & bit ) == 0 ? 1 : 0;
+            w |= bit;
+            return;
+        }
+        auto const it = std::lower_bound( c.values.begin(), c.values.end(), v );
+        if ( it != c.values.end() && *it == v ) {
+            return;
+        }
+        c.values.insert( it, v );
+        if ( ++c.card > array_max ) {
+            auto words = to_words( c );
+            c = container{ container::kind::bitmap, c.card, {}, std::move( words ) };
+        }
+    }
+    static void remove( container& c, std::uint16_t const v )
+    {
+        materialize( c );
+        if ( c.type == container::kind::bitmap ) {
+            auto& w = c.words[ v / 64 ];
+            auto const bit = std::uint64_t{ 1 } << ( v % 64 );
+            c.card -= ( w & bit ) != 0 ? 1 : 0;
+            w &= ~bit;
+            if ( c.card <= array_max ) {
+                c = from_words( std::move( c.words ), false );
+            }
+            return;
+        }
+        auto const it = std::lower_bound( c.values.begin(), c.values.end(), v );
+        if ( it != c.values.end() && *it == v ) {
+            c.values.erase( it );
+            --c.card;
+        }
+    }
+    template < typename fn_t >
+    static void for_each_run( container const& c, fn_t&& fn )
+    {   // invoke fn( lo, hi ) for every run [lo, hi) of the container
+        switch ( c.type ) {
+        case container::kind::array:
+            for ( auto i = std::size_t{ 0 }; i < c.values.size(); ) {
+                auto j = i + 1;
+                while ( j < c.values.size() && c.values[ j ] == c.values[ j - 1 ] + 1 ) {
+                    ++j;
+                }
+                fn( std::uint32_t{ c.values[ i ] }, c.values[ j - 1 ] + 1u );
+                i = j;
+            }
+            break;
+        case container::kind::bitmap:
+            for ( auto lo = next_bit( c.words, 0, true ); lo < chunk_bits; ) {
+                auto const hi = next_bit( c.words, lo, false );
+                fn( lo, hi );
+                lo = next_bit( c.words, hi, true );
+            }
+            break;
+        case container::kind::run:
+            for ( auto i = std::size_t{ 0 }; i < c.values.size(); i += 2 ) {
+                fn( std::uint32_t{ c.values[ i ] }, c.values[ i + 1 ] + 1u );
+            }
+            break;
+        }
+    }
+
+    class run_cursor
+    {   // maximal runs [lo, hi) of a container in ascending order, without materializing them
+    public:
+        explicit run_cursor( container const& c ) :
+            c_{ c }
+        {
+            fetch();
+            next();
+        }
+
+        [[nodiscard]] auto done() const -> bool {
+            return lo_ == chunk_bits;
+        }
+        [[nodiscard]] auto lo() const -> std::uint32_t {
+            return lo_;
+        }
+        [[nodiscard]] auto hi() const -> std::uint32_t {
+            return hi_;
+        }
+        void next()
+        {   // merge the pieces that touch, array values and adjacent runs
+            lo_ = next_lo_;
+            hi_ = next_hi_;
+            fetch();
+            while ( next_lo_ != chunk_bits && next_lo_ == hi_ ) {
+                hi_ = next_hi_;
+                fetch();
+            }
+        }
+
+    private:
+        void fetch()
+        {   // next piece of the container into next_lo_ / next_hi_, chunk_bits when exhausted
+            next_lo_ = chunk_bits;
+            switch ( c_.type ) {
+            case container::kind::array:
+                if ( pos_ < c_.values.size() ) {
+                    next_lo_ = c_.values[ pos_++ ];
+                    next_hi_ = next_lo_ + 1;
+                }
+                break;
+            case container::kind::run:
+                if ( pos_ < c_.values.size() ) {
+                    next_lo_ = c_.values[ pos_ ];
+                    next_hi_ = c_.values[ pos_ + 1 ] + 1u;
+                    pos_ += 2;
+                }
+                break;
+            case container::kind::bitmap:
+                next_lo_ = next_bit( c_.words, static_cast< std::uint32_t >( pos_ ), true );
+                next_hi_ = next_bit( c_.words, next_lo_, false );
+                pos_ = next_hi_;
+                break;
+            }
+        }
+
+        container const& c_;
+        std::size_t pos_{};
+        std::uint32_t lo_{};
+        std::uint32_t hi_{};
+        std::uint32_t next_lo_{};
+        std::uint32_t next_hi_{};
+    };
+    [[nodiscard]] static auto equal( container const& a, container const& b ) -> bool
+    {   // same values, regardless of container kind
+        if ( a.card != b.card ) {
+            return false;
+        }
+        if ( a.type == b.type && a.type != container::kind::run ) {
+            return a.type == container::kind::array ? a.values == b.values : a.words == b.words;
+        }
+        auto x = run_cursor{ a };
+        auto y = run_cursor{ b };
+        for ( ; !x.done() && !y.done(); x.next(), y.next() ) {
+            if ( x.lo() != y.lo() || x.hi() != y.hi() ) {
+                return false;
+            }
+        }
+        return x.done() && y.done();
+    }
+
+    // container algebra
+    [[nodiscard]] static auto combine( container const& a, container const& b, op const o ) -> container
+    {
+        using kind = container::kind;
+        if ( a.type == kind::array && b.type == kind::array ) {
+            auto ret = container{};
+            ret.values.reserve( o == op::or_ ? a.values.size() + b.values.size() : a.values.size() );
+            auto out = std::back_inserter( ret.values );
+            switch ( o ) {
+            case op::or_:
+                std::set_union( a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out );
+                break;
+            case op::and_:
+                std::set_intersection( a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out );
+                break;
+            case op::andnot:
+                std::set_difference( a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), out );
+                break;
+            }
+            ret.card = static_cast< std::uint32_t >( ret.values.size() );
+            return ret.card > array_max ? from_words( to_words( ret ) ) : ret;
+        }
+        if ( a.type != kind::bitmap && b.type != kind::bitmap ) {
+            // run x run and array x run: sweep both boundary lists, an array value v is the run
+            // [ v, v ], emitting a boundary wherever membership changes
+            auto ret = container{ kind::run, 0, {}, {} };
+            auto const bounds = []( container const& c ) {
+                return c.type == kind::run ? c.values.size() : 2 * c.values.size();
+            };
+            auto const bound = []( container const& c, std::size_t const i ) {
+                auto const v = c.values[ c.type == kind::run ? i : i / 2 ];
+                return i % 2 == 0 ? std::uint32_t{ v } : v + 1u;
+            };
+            auto const na = bounds( a );
+            auto const nb = bounds( b );
+            auto i = std::size_t{ 0 };
+            auto j = std::size_t{ 0 };
+            auto inside = false;
+            auto start = std::uint32_t{ 0 };
+            while ( i < na || j < nb ) {
+                auto const x = j == nb || ( i < na && bound( a, i ) < bound( b, j ) ) ? bound( a, i ) : bound( b, j );
+                while ( i < na && bound( a, i ) == x ) {
+                    ++i;
+                }
+                while ( j < nb && bound( b, j ) == x ) {
+                    ++j;
+                }
+                // an odd number of boundaries passed means x is inside that container
+                auto const ia = i % 2 == 1;
+                auto const ib = j % 2 == 1;
+                auto const now = o == op::or_ ? ( ia || ib ) : o == op::and_ ? ( ia && ib ) : ( ia && !ib );
+                if ( now && !inside ) {
+                    start = x;
+                }
+                else if ( !now && inside ) {
+                    ret.values.push_back( static_cast< std::uint16_t >( start ) );
+                    ret.values.push_back( static_cast< std::uint16_t >( x - 1 ) );
+                    ret.card += x - start;
+                }
+                inside = now;
+            }
+            return from_runs( std::move( ret ) );
+        }
+        auto wa = to_words( a );
+        auto const wb = to_words( b );
+        switch ( o ) {
+        case op::or_:
+            for ( auto i = std::size_t{ 0 }; i < chunk_words; ++i ) {
+                wa[ i ] |= wb[ i ];
+            }
+            break;
+        case op::and_:
+            for ( auto i = std::size_t{ 0 }; i < chunk_words; ++i ) {
+                wa[ i ] &= wb[ i ];
+            }
+            break;
+        case op::andnot:
+            for ( auto i = std::size_t{ 0 }; i < chunk_words; ++i ) {
+                wa[ i ] &= ~wb[ i ];
+            }
+            break;
+        }
+        return from_words( std::move( wa ) );
+    }
+    [[nodiscard]] static auto combine( index_bitmap const& a, index_bitmap const& b, op const o ) -> index_bitmap
+    {   // merge the chunk lists by key
+        auto ret = index_bitmap{};
+        auto i = std::size_t{ 0 };
+        auto j = std::size_t{ 0 };
+        while ( i < a.chunks_.size() || j < b.chunks_.size() ) {
+            auto const only_a = j == b.chunks_.size() || ( i < a.chunks_.size() && a.chunks_[ i ].key < b.chunks_[ j ].key );
+            auto const only_b = !only_a && ( i == a.chunks_.size() || b.chunks_[ j ].key < a.chunks_[ i ].key );
+            if ( only_a ) {
+                if ( o != op::and_ ) {
+                    ret.chunks_.push_back( a.chunks_[ i ] );
+                }
+                ++i;
+            }
+            else if ( only_b ) {
+                if ( o == op::or_ ) {
+                    ret.chunks_.push_back( b.chunks_[ j ] );
+                }
+                ++j;
+            }
+            else {
+                auto c = combine( a.chunks_[ i ].c, b.chunks_[ j ].c, o );
+                if ( c.card != 0 ) {
+                    ret.chunks_.push_back( chunk{ a.chunks_[ i ].key, std::move( c ) } );
+                }
+                ++i;
+                ++j;
+            }
+        }
+        return ret;
+    }
+
+    std::vector< chunk > chunks_;   // sorted by key, no empty containers
+};
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_BITMAP_H_
@@ -0,0 +1,174 @@
+// range_chrono.h
+//
+// std::chrono time_point ranges with a duration step, e.g. [t0, t1) in 10s buckets
+// stored as a range of ticks so size, indexing and membership are the integer range
+// operations; bucket_of maps any timestamp to its bucket in O(1) without a division
+// e.g.
+//     using namespace std::chrono_literals;
+//     auto const buckets = roam::time_range{ t0, t0 + 1h, 10s };
+//     for ( auto const t : buckets ) {}                      // t0, t0 + 10s, ...
+//     auto const b = buckets.bucket_of( event.time );        // -1 when outside [t0, t0 + 1h)
+//     buckets.bucket_of( stamps.data(), stamps.size(), ids.data() );
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_CHRONO_H_
+#define _INC_ROAM_RANGE_CHRONO_H_
+
+#include "range.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+// ascending range of time points start, start + step, ... < stop
+template < typename clock_type, typename duration_t = typename clock_type::duration >
+class time_range
+{
+public:
+    using time_point = std::chrono::time_point< clock_type, duration_t >;
+    using duration = duration_t;
+    using rep = typename duration_t::rep;
+    using value_type = time_point;
+
+    constexpr explicit time_range( time_point const& start, time_point const& stop, duration_t const& step ) :
+        ticks_{ start.time_since_epoch().count(), stop.time_since_epoch().count(), step.count() },
+        step_{ step.count() }
+    {   // @example: time_range{ t0, t0 + 1h, 10s }
+        // @requires: time ranges ascend
+        assert( step > duration_t::zero() );
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return ticks_.size();
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return ticks_.empty();
+    }
+    [[nodiscard]] constexpr auto start() const -> time_point
+    {
+        return time_point{ duration_t{ ticks_.start() } };
+    }
+    [[nodiscard]] constexpr auto stop() const -> time_point
+    {
+        return time_point{ duration_t{ ticks_.stop() } };
+    }
+    [[nodiscard]] constexpr auto step() const -> duration_t
+    {
+        return duration_t{ ticks_.step() };
+    }
+    [[nodiscard]] constexpr auto ticks() const -> range< rep > const&
+    {   // @return the underlying range of tick counts
+        return ticks_;
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx ) const -> time_point
+    {
+        return time_point{ duration_t{ ticks_[ idx ] } };
+    }
+
+    [[nodiscard]] constexpr auto index_of( time_point const& t ) const -> std::ptrdiff_t
+    {   // @return index of 't' if it is exactly one of the range's time points, else -1
+        return ticks_.index_of( t.time_since_epoch().count() );
+    }
+    [[nodiscard]] constexpr auto contains( time_point const& t ) const -> bool
+    {
+        return index_of( t ) >= 0;
+    }
+    [[nodiscard]] constexpr auto bucket_of( time_point const& t ) const -> std::ptrdiff_t
+    {   // @return i such that t is in [ range[ i ], range[ i ] + step ), -1 if 't' is outside [start, stop)
+        // @example: time_range{ t0, t0 + 60s, 10s }.bucket_of( t0 + 25s ) == 2
+        auto const v = t.time_since_epoch().count();
+        if ( v < ticks_.start() || v >= ticks_.stop() ) {
+            return -1;
+        }
+        if constexpr ( std::is_integral_v< rep > ) {
+            return static_cast< std::ptrdiff_t >( step_.divide( detail::abs_diff( v, ticks_.start() ) ) );
+        }
+        else {
+            return static_cast< std::ptrdiff_t >( ( v - ticks_.start() ) / ticks_.step() );
+        }
+    }
+    void bucket_of( time_point const* in, std::size_t const n, std::ptrdiff_t* out ) const
+    {   // out[ i ] = bucket_of( in[ i ] ) for 'n' timestamps
+        // @note: the quotient comes from a double reciprocal corrected by one step either way,
+        //        so the loop is branch and division free and vectorizes; exact while the
+        //        offsets are < 2^53 ticks and the bucket count is < 2^51, wider ranges take
+        //        the exact per timestamp path
+        auto const first = ticks_.start();
+        auto const last = ticks_.stop();
+        auto const step = ticks_.step();
+        if constexpr ( std::is_integral_v< rep > ) {
+            auto const span = static_cast< std::uint64_t >( detail::abs_diff( last, first ) );
+            if ( span >= ( std::uint64_t{ 1 } << 53 ) || size() >= ( std::size_t{ 1 } << 51 ) ) {
+                for ( auto i = std::size_t{ 0 }; i < n; ++i ) {
+                    out[ i ] = bucket_of( in[ i ] );
+                }
+                return;
+            }
+            auto const inv = 1.0 / static_cast< double >( step );
+            for ( auto i = std::size_t{ 0 }; i < n; ++i ) {
+                // offset from first in wrapping arithmetic, a single unsigned compare against the
+                // span tells the lanes inside the range. lanes outside compute with offset 0 and
+                // are masked below, so every conversion and correction stays in range
+                auto const offset = static_cast< std::uint64_t >( in[ i ].time_since_epoch().count() ) - static_cast< std::uint64_t >( first );
+                auto const inside = static_cast< std::uint64_t >( offset < span );
+                auto const d = static_cast< std::int64_t >( offset & ( 0 - inside ) );
+                auto q = static_cast< std::int64_t >( static_cast< double >( d ) * inv );
+                auto const r = d - q * static_cast< std::int64_t >( step );
+                q -= r < 0 ? 1 : 0;
+                q += r >= static_cast< std::int64_t >( step ) ? 1 : 0;
+                // or with all ones ( -1 ) outside the range, a select would be a branch
+                auto const outside = static_cast< std::int64_t >( inside - 1 );
+                out[ i ] = static_cast< std::ptrdiff_t >( q | outside );
+            }
+        }
+        else {
+            for ( auto i = std::size_t{ 0 }; i < n; ++i ) {
+                auto const v = in[ i ].time_since_epoch().count();
+                out[ i ] = v >= first && v < last ? static_cast< std::ptrdiff_t >( ( v - first ) / step ) : -1;
+            }
+        }
+    }
+    template < typename in_t, typename out_t >
+    void bucket_of( in_t const& in, out_t& out ) const
+    {   // @example: buckets.bucket_of( std::vector< time_point >{ ... }, std::vector< std::ptrdiff_t >( n ) )
+        // @requires: output at least as long as the input
+        assert( std::size( out ) >= std::size( in ) );
+        bucket_of( std::data( in ), std::size( in ), std::data( out ) );
+    }
+
+    using iterator = detail::index_iterator< time_range >;
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, gsl::narrow< std::ptrdiff_t >( size() ) };
+    }
+
+private:
+    // a reciprocal step only exists for integral tick counts
+    struct no_step
+    {
+        constexpr explicit no_step( rep const& ) {}
+    };
+
+    range< rep > ticks_;
+    std::conditional_t< std::is_integral_v< rep >, precomputed_step< rep >, no_step > step_;
+};
+
+template < typename clock_type, typename duration_t, typename rep_t, typename period_t >
+time_range( std::chrono::time_point< clock_type, duration_t > const&, std::chrono::time_point< clock_type, duration_t > const&,
+            std::chrono::duration< rep_t, period_t > const& ) -> time_range< clock_type, duration_t >;
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_CHRONO_H_
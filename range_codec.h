@@ -0,0 +1,282 @@
+// range_codec.h
+//
+// arithmetic progression compression of index lists
+// the sequence is split greedily into maximal progressions ( stored as start, step, count )
+// and literal stretches; order is preserved so sorted and unsorted lists both encode.
+// a progression is one range< int64_t >, values or steps it can not hold stay literals
+// random access goes through a sampled skip index over the segments
+// e.g.
+//     auto const list = roam::progression_list< uint32_t >{ indices };
+//     auto const v = list[ 12345 ];
+//     list.decode( out.data() );
+//     list.for_each_run( []( roam::range< int64_t > const& r ) {} );
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_CODEC_H_
+#define _INC_ROAM_RANGE_CODEC_H_
+
+#include "range.h"
+
+#include <algorithm>   // for upper_bound / copy
+#include <cstdint>
+#include <iterator>    // for std::size / std::data
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+template < typename ty_t >
+class progression_list
+{
+    static_assert( std::is_integral_v< ty_t >, "progression_list holds integral indices" );
+
+public:
+    using value_type = ty_t;
+
+    struct segment
+    {
+        std::int64_t start{};      // first value, or offset into the literals for literal segments
+        std::int64_t step{};       // non-zero for progressions
+        std::uint32_t count{};
+        bool literal{};
+
+        [[nodiscard]] constexpr auto run() const -> range< std::int64_t >
+        {   // @return progression as a range
+            // @requires: not a literal segment
+            // @note: encode keeps the stop within int64_t, step * count alone may not be
+            assert( !literal );
+            auto const stop = static_cast< std::uint64_t >( start ) + static_cast< std::uint64_t >( step ) * count;
+            return range< std::int64_t >{ start, static_cast< std::int64_t >( stop ), step };
+        }
+    };
+
+    // every skip_stride'th segment's first element index is sampled for random access
+    static auto constexpr skip_stride = std::size_t{ 16 };
+    // most elements of one segment, longer runs of either kind are split
+    static auto constexpr max_count = std::size_t{ UINT32_MAX };
+    // shortest progression worth a segment of its own rather than literals
+    static auto constexpr min_run = std::size_t{ sizeof( segment ) / sizeof( ty_t ) + 1 > 3 ? sizeof( segment ) / sizeof( ty_t ) + 1 : 3 };
+
+    progression_list() = default;
+    explicit progression_list( ty_t const* data, std::size_t const n )
+    {
+        encode( data, n );
+    }
+    template < typename con_t >
+    explicit progression_list( con_t const& c ) :
+        progression_list{ std::data( c ), std::size( c ) }
+    {   // @example: progression_list< uint32_t >{ std::vector< uint32_t >{ 0, 3, 6, 9, ... } }
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return size_;
+    }
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return 0 == size_;
+    }
+    [[nodiscard]] auto bytes() const -> std::size_t
+    {   // @return encoded size in bytes
+        return segments_.size() * sizeof( segment ) + literals_.size() * sizeof( ty_t ) + skip_.size() * sizeof( std::size_t );
+    }
+    [[nodiscard]] auto segments() const -> std::vector< segment > const&
+    {
+        return segments_;
+    }
+    [[nodiscard]] auto literals() const -> std::vector< ty_t > const&
+    {
+        return literals_;
+    }
+
+    [[nodiscard]] auto operator[]( std::ptrdiff_t const idx_in ) const -> ty_t
+    {   // @return element 'idx', O(log( segments / skip_stride ) + skip_stride)
+        auto const idx = static_cast< std::size_t >( idx_in >= 0 ? idx_in : static_cast< std::ptrdiff_t >( size_ ) + idx_in );
+        // @requires: valid index
+        assert( idx < size_ );
+        auto const sample = static_cast< std::size_t >( std::upper_bound( skip_.begin(), skip_.end(), idx ) - skip_.begin() ) - 1;
+        auto s = sample * skip_stride;
+        auto first = skip_[ sample ];
+        while ( first + segments_[ s ].count <= idx ) {
+            first += segments_[ s++ ].count;
+        }
+        return value( segments_[ s ], idx - first );
+    }
+
+    void decode( ty_t* out ) const
+    {   // write all 'size()' elements to 'out'
+        // @note: progressions expand with an independent multiply-add per lane, which vectorizes
+        for ( auto const& seg : segments_ ) {
+            if ( seg.literal ) {
+                auto const src = literals_.begin() + static_cast< std::ptrdiff_t >( seg.start );
+                out = std::copy( src, src + seg.count, out );
+                continue;
+            }
+            // modulo 2^N in an unsigned type at least as wide as int, no promotion to a signed type
+            using counter_t = std::common_type_t< std::make_unsigned_t< ty_t >, unsigned int >;
+            auto const start = static_cast< counter_t >( static_cast< ty_t >( seg.start ) );
+            auto const step = static_cast< counter_t >( static_cast< ty_t >( seg.step ) );
+            for ( auto i = std::uint32_t{ 0 }; i < seg.count; ++i ) {
+                out[ i ] = static_cast< ty_t >( start + step * static_cast< counter_t >( i ) );
+            }
+            out += seg.count;
+        }
+    }
+    [[nodiscard]] auto to_vector() const -> std::vector< ty_t >
+    {
+        auto ret = std::vector< ty_t >( size_ );
+        decode( ret.data() );
+        return ret;
+    }
+
+    template < typename fn_t >
+    void for_each_run( fn_t&& fn ) const
+    {   // invoke fn( range< int64_t > ) for each progression segment
+        for ( auto const& seg : segments_ ) {
+            if ( !seg.literal ) {
+                fn( seg.run() );
+            }
+        }
+    }
+
+    // iteration, walks the segments without searching
+    class iterator
+    {   // iterator holds reference to progression_list and is invalidated if it is destroyed
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = ty_t;
+        using reference = ty_t;
+        using pointer = ty_t*;
+        using iterator_category = std::forward_iterator_tag;
+
+        explicit iterator( progression_list const& list, std::size_t const segment ) :
+            list_{ list },
+            segment_{ segment }
+        {
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return &list_ == &rhs.list_ && segment_ == rhs.segment_ && pos_ == rhs.pos_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            if ( ++pos_ == list_.segments_[ segment_ ].count ) {
+                ++segment_;
+                pos_ = 0;
+            }
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() const -> reference {
+            return list_.value( list_.segments_[ segment_ ], pos_ );
+        }
+
+    private:
+        progression_list const& list_;
+        std::size_t segment_{};
+        std::size_t pos_{};
+    };
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, segments_.size() };
+    }
+
+private:
+    [[nodiscard]] auto value( segment const& seg, std::size_t const pos ) const -> ty_t
+    {
+        return seg.literal ? literals_[ static_cast< std::size_t >( seg.start ) + pos ]
+                           : static_cast< ty_t >( static_cast< std::uint64_t >( seg.start ) + static_cast< std::uint64_t >( seg.step ) * pos );
+    }
+
+    void encode( ty_t const* x, std::size_t const n )
+    {   // greedy: take the longest progression starting at each position, literals otherwise
+        constexpr auto int64_max = static_cast< std::uint64_t >( INT64_MAX );
+        auto const fits = [&]( std::size_t const i ) {
+            // values of unsigned 64 bit types above INT64_MAX have no int64_t run
+            return std::is_signed_v< ty_t > || static_cast< std::uint64_t >( x[ i ] ) <= int64_max;
+        };
+        auto const diff = [&]( std::size_t const i ) -> std::int64_t {
+            // @return x[ i + 1 ] - x[ i ], or 0 when either value or the difference does not fit int64_t.
+            // the difference is taken in std::uint64_t, exact modulo 2^64 for values that fit
+            if ( !fits( i ) || !fits( i + 1 ) ) {
+                return 0;
+            }
+            auto const a = static_cast< std::uint64_t >( x[ i ] );
+            auto const b = static_cast< std::uint64_t >( x[ i + 1 ] );
+            auto const up = static_cast< std::int64_t >( a ) <= static_cast< std::int64_t >( b );
+            auto const d = up ? b - a : a - b;
+            return d > int64_max ? 0 : up ? static_cast< std::int64_t >( d ) : -static_cast< std::int64_t >( d );
+        };
+        auto const stop_fits = [&]( std::size_t const last, std::int64_t const d ) {
+            // the run's stop, one step past 'last', is within int64_t
+            auto const v = static_cast< std::int64_t >( x[ last ] );
+            return d > 0 ? v <= INT64_MAX - d : v >= INT64_MIN - d;
+        };
+        auto const push = [&]( segment const& seg ) {
+            if ( segments_.size() % skip_stride == 0 ) {
+                skip_.push_back( size_ );
+            }
+            segments_.push_back( seg );
+            size_ += seg.count;
+        };
+        auto literal_begin = literals_.size();
+        auto const flush = [&] {
+            if ( literals_.size() > literal_begin ) {
+                push( segment{ static_cast< std::int64_t >( literal_begin ), 0, gsl::narrow< std::uint32_t >( literals_.size() - literal_begin ), true } );
+            }
+            literal_begin = literals_.size();
+        };
+
+        for ( auto i = std::size_t{ 0 }; i < n; ) {
+            auto j = i + 1;
+            if ( j < n && diff( i ) != 0 ) {
+                auto const d = diff( i );
+                while ( j + 1 < n && diff( j ) == d && j + 1 - i < max_count ) {
+                    ++j;
+                }
+                if ( !stop_fits( j, d ) ) {
+                    // the previous element is the stop then, it is a value
+                    --j;
+                }
+                if ( j + 1 - i >= min_run ) {
+                    flush();
+                    push( segment{ static_cast< std::int64_t >( x[ i ] ), d, gsl::narrow< std::uint32_t >( j + 1 - i ), false } );
+                    i = j + 1;
+                    continue;
+                }
+            }
+            literals_.push_back( x[ i++ ] );
+            if ( literals_.size() - literal_begin == max_count ) {
+                flush();
+            }
+        }
+        flush();
+        segments_.shrink_to_fit();
+        literals_.shrink_to_fit();
+        skip_.shrink_to_fit();
+    }
+
+    std::vector< segment > segments_;
+    std::vector< ty_t > literals_;
+    std::vector< std::size_t > skip_;   // first element index of every skip_stride'th segment
+    std::size_t size_{};
+};
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_CODEC_H_
@@ -0,0 +1,212 @@
+// range_enum.h
+//
+// typed enum ranges and a dense enum keyed map
+// enum_range< E > yields E itself, no cast in the loop body. enum_count< E > is the number of
+// enumerators, taken from a trailing 'count' or 'max' enumerator or from a specialization of
+// enum_traits< E >. enum_map< E, T > is a std::array< T, enum_count< E > > indexed by E, a
+// replacement for std::unordered_map< E, T > when the enumerators are 0, 1, ... count - 1
+// e.g.
+//     enum class stage { parse, plan, run, max };
+//     for ( auto const s : roam::enum_range< stage >{} ) { do_smth( s ); }
+//     auto ms = roam::enum_map< stage, double >{};
+//     ms[ stage::run ] += 1.5;
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_ENUM_H_
+#define _INC_ROAM_RANGE_ENUM_H_
+
+#include "range.h"
+
+#include <array>
+#include <initializer_list>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+namespace detail
+{
+    template < typename enum_t, typename = void >
+    struct has_count_enumerator : std::false_type {};
+    template < typename enum_t >
+    struct has_count_enumerator< enum_t, std::void_t< decltype( enum_t::count ) > > : std::true_type {};
+
+    template < typename enum_t, typename = void >
+    struct has_max_enumerator : std::false_type {};
+    template < typename enum_t >
+    struct has_max_enumerator< enum_t, std::void_t< decltype( enum_t::max ) > > : std::true_type {};
+} // detail
+
+// number of enumerators, specialize for enums without a 'count' or 'max' sentinel
+// e.g. template <> struct roam::enum_traits< color > { static constexpr std::size_t count = 3; };
+template < typename enum_t >
+struct enum_traits
+{
+    static_assert( std::is_enum_v< enum_t >, "enum_traits is for enum types" );
+    static_assert( detail::has_count_enumerator< enum_t >::value || detail::has_max_enumerator< enum_t >::value,
+                   "enum needs a 'count' or 'max' enumerator, or a specialization of roam::enum_traits" );
+
+    static constexpr auto sentinel() -> enum_t
+    {
+        if constexpr ( detail::has_count_enumerator< enum_t >::value ) {
+            return enum_t::count;
+        }
+        else {
+            return enum_t::max;
+        }
+    }
+    static constexpr std::size_t count = static_cast< std::size_t >( sentinel() );
+};
+
+template < typename enum_t >
+inline constexpr std::size_t enum_count = enum_traits< enum_t >::count;
+
+template < typename enum_t, typename ty_t >
+[[nodiscard]] constexpr auto enum_cast( ty_t const& v ) -> enum_t
+{   // @return the enumerator with value 'v'
+    // @requires: 'v' is one of the counted enumerators
+    if constexpr ( std::is_signed_v< ty_t > ) {
+        assert( v >= 0 );
+    }
+    assert( static_cast< std::size_t >( v ) < enum_count< enum_t > );
+    return static_cast< enum_t >( v );
+}
+
+// range of enumerators, iteration yields enum_t
+template < typename enum_t >
+class enum_range
+{
+    static_assert( std::is_enum_v< enum_t >, "enum_range is for enum types" );
+
+public:
+    using underlying_type = std::underlying_type_t< enum_t >;
+    using value_type = enum_t;
+
+    constexpr enum_range() :
+        range_{ static_cast< underlying_type >( enum_count< enum_t > ) }
+    {   // @example: enum_range< stage >{} -> parse, plan, run
+    }
+    constexpr explicit enum_range( enum_t const first, enum_t const last ) :
+        range_{ static_cast< underlying_type >( first ), static_cast< underlying_type >( last ) }
+    {   // @example: enum_range{ stage::plan, stage::max } -> plan, run
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return range_.size();
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return range_.empty();
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx ) const -> enum_t
+    {
+        return static_cast< enum_t >( range_[ idx ] );
+    }
+    [[nodiscard]] constexpr auto contains( enum_t const e ) const -> bool
+    {
+        return range_.contains( static_cast< underlying_type >( e ) );
+    }
+    [[nodiscard]] constexpr auto underlying() const -> range< underlying_type > const&
+    {   // @return the range of underlying values
+        return range_;
+    }
+
+    using iterator = detail::index_iterator< enum_range >;
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, gsl::narrow< std::ptrdiff_t >( size() ) };
+    }
+
+private:
+    range< underlying_type > range_;
+};
+
+template < typename enum_t >
+enum_range( enum_t, enum_t ) -> enum_range< enum_t >;
+
+// dense map from every enumerator to a value, a flat std::array indexed by the enum
+template < typename enum_t, typename ty_t >
+class enum_map
+{
+public:
+    using key_type = enum_t;
+    using mapped_type = ty_t;
+    using storage_type = std::array< ty_t, enum_count< enum_t > >;
+    using iterator = typename storage_type::iterator;
+    using const_iterator = typename storage_type::const_iterator;
+
+    constexpr enum_map() = default;
+    constexpr explicit enum_map( ty_t const& v )
+    {   // @example: enum_map< stage, int >{ -1 } -> every stage maps to -1
+        for ( auto& x : values_ ) {
+            x = v;
+        }
+    }
+    constexpr enum_map( std::initializer_list< std::pair< enum_t, ty_t > > const init )
+    {   // @example: enum_map< stage, char const* >{ { stage::parse, "parse" }, { stage::run, "run" } }
+        for ( auto const& [ k, v ] : init ) {
+            ( *this )[ k ] = v;
+        }
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return values_.size();
+    }
+    [[nodiscard]] constexpr auto operator[]( enum_t const key ) -> ty_t&
+    {
+        return values_[ index( key ) ];
+    }
+    [[nodiscard]] constexpr auto operator[]( enum_t const key ) const -> ty_t const&
+    {
+        return values_[ index( key ) ];
+    }
+    [[nodiscard]] constexpr auto keys() const -> enum_range< enum_t >
+    {   // @return every key in index order, parallel to begin() .. end()
+        return enum_range< enum_t >{};
+    }
+    [[nodiscard]] constexpr auto values() -> storage_type&
+    {
+        return values_;
+    }
+    [[nodiscard]] constexpr auto values() const -> storage_type const&
+    {
+        return values_;
+    }
+
+    // iteration over the values, in enumerator order
+    [[nodiscard]] constexpr auto begin() -> iterator {
+        return values_.begin();
+    }
+    [[nodiscard]] constexpr auto end() -> iterator {
+        return values_.end();
+    }
+    [[nodiscard]] constexpr auto begin() const -> const_iterator {
+        return values_.begin();
+    }
+    [[nodiscard]] constexpr auto end() const -> const_iterator {
+        return values_.end();
+    }
+
+private:
+    [[nodiscard]] static constexpr auto index( enum_t const key ) -> std::size_t
+    {   // @requires: 'key' is one of the counted enumerators
+        auto const idx = static_cast< std::size_t >( key );
+        assert( idx < enum_count< enum_t > );
+        return idx;
+    }
+
+    storage_type values_{};
+};
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_ENUM_H_
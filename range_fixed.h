@@ -0,0 +1,196 @@
+// range_fixed.h
+//
+// fixed point and decimal values ( scaled integers ) and exact ranges over them
+// fixed_point< rep, scale > stores value * scale in an integer, decimal< digits > is the
+// base 10 case, e.g. decimal< 2 > holds cents. a range of them is a range of the raw integers,
+// so size, indexing and membership are exact integer operations, loops run on integer alus
+// and conversion to double happens only at the edges
+// e.g.
+//     using price = roam::decimal< 2 >;
+//     auto const ladder = roam::range{ price{ 99.50 }, price{ 100.50 }, price{ 0.01 } };   // exactly 100 ticks
+//     for ( auto const p : ladder ) { quote( static_cast< double >( p ) ); }
+//     auto const level = ladder.index_of( price{ 100.00 } );                                // 50
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_FIXED_H_
+#define _INC_ROAM_RANGE_FIXED_H_
+
+#include "range.h"
+
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+namespace detail
+{
+    [[nodiscard]] constexpr auto pow10( int const digits ) -> std::intmax_t
+    {
+        auto ret = std::intmax_t{ 1 };
+        for ( auto i = 0; i < digits; ++i ) {
+            ret *= 10;
+        }
+        return ret;
+    }
+} // detail
+
+// value * scale held in an integer
+template < typename rep_t, std::intmax_t scale >
+class fixed_point
+{
+    static_assert( std::is_integral_v< rep_t > && std::is_signed_v< rep_t >, "fixed_point needs a signed integer representation" );
+    static_assert( scale > 0 && scale <= static_cast< std::intmax_t >( std::numeric_limits< rep_t >::max() ), "fixed_point scale must fit the representation" );
+
+public:
+    using rep = rep_t;
+    static auto constexpr denominator = static_cast< rep_t >( scale );
+
+    constexpr fixed_point() = default;
+    constexpr explicit fixed_point( double const v ) :
+        raw_{ static_cast< rep_t >( v * static_cast< double >( scale ) + ( v < 0.0 ? -0.5 : 0.5 ) ) }
+    {   // @example: decimal< 2 >{ 0.01 }.raw() == 1, rounded to the nearest unit
+    }
+
+    [[nodiscard]] static constexpr auto from_raw( rep_t const raw ) -> fixed_point
+    {   // @example: decimal< 2 >::from_raw( 10125 ) == decimal< 2 >{ 101.25 }
+        auto ret = fixed_point{};
+        ret.raw_ = raw;
+        return ret;
+    }
+    [[nodiscard]] constexpr auto raw() const -> rep_t
+    {
+        return raw_;
+    }
+    [[nodiscard]] constexpr explicit operator double() const
+    {
+        return static_cast< double >( raw_ ) / static_cast< double >( scale );
+    }
+
+    // exact arithmetic, overflow is the caller's concern as for the raw integers
+    [[nodiscard]] friend constexpr auto operator+( fixed_point const& a, fixed_point const& b ) -> fixed_point {
+        return from_raw( static_cast< rep_t >( a.raw_ + b.raw_ ) );
+    }
+    [[nodiscard]] friend constexpr auto operator-( fixed_point const& a, fixed_point const& b ) -> fixed_point {
+        return from_raw( static_cast< rep_t >( a.raw_ - b.raw_ ) );
+    }
+    [[nodiscard]] friend constexpr auto operator-( fixed_point const& a ) -> fixed_point {
+        return from_raw( static_cast< rep_t >( -a.raw_ ) );
+    }
+    [[nodiscard]] friend constexpr auto operator*( fixed_point const& a, rep_t const n ) -> fixed_point {
+        return from_raw( static_cast< rep_t >( a.raw_ * n ) );
+    }
+
+    [[nodiscard]] friend constexpr auto operator==( fixed_point const& a, fixed_point const& b ) -> bool {
+        return a.raw_ == b.raw_;
+    }
+    [[nodiscard]] friend constexpr auto operator!=( fixed_point const& a, fixed_point const& b ) -> bool {
+        return a.raw_ != b.raw_;
+    }
+    [[nodiscard]] friend constexpr auto operator<( fixed_point const& a, fixed_point const& b ) -> bool {
+        return a.raw_ < b.raw_;
+    }
+    [[nodiscard]] friend constexpr auto operator<=( fixed_point const& a, fixed_point const& b ) -> bool {
+        return a.raw_ <= b.raw_;
+    }
+    [[nodiscard]] friend constexpr auto operator>( fixed_point const& a, fixed_point const& b ) -> bool {
+        return a.raw_ > b.raw_;
+    }
+    [[nodiscard]] friend constexpr auto operator>=( fixed_point const& a, fixed_point const& b ) -> bool {
+        return a.raw_ >= b.raw_;
+    }
+
+private:
+    rep_t raw_{};
+};
+
+// 'digits' decimal places, e.g. decimal< 2 > for cents, decimal< 8 > for satoshis
+template < int digits, typename rep_t = std::int64_t >
+using decimal = fixed_point< rep_t, detail::pow10( digits ) >;
+
+// range of fixed point values, a range of the raw integers underneath
+template < typename rep_t, std::intmax_t scale, typename policy_t >
+class range< fixed_point< rep_t, scale >, policy_t >
+{
+public:
+    using value_type = fixed_point< rep_t, scale >;
+    using policy_type = policy_t;
+
+    constexpr explicit range( value_type const& start, value_type const& stop, value_type const& step ) :
+        raw_{ start.raw(), stop.raw(), step.raw() }
+    {   // @example: range{ decimal< 2 >{ 1.0 }, decimal< 2 >{ 2.0 }, decimal< 2 >{ 0.25 } } -> 1.00, 1.25, 1.50, 1.75
+    }
+    constexpr explicit range( range< rep_t, policy_t > const& raw ) :
+        raw_{ raw }
+    {   // @example: range< decimal< 2 > >{ range< int64_t >{ 100, 200 } } -> 1.00, 1.01, ... 1.99
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {   // @return exact number of steps, no rounding involved
+        return raw_.size();
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return raw_.empty();
+    }
+    [[nodiscard]] constexpr auto start() const -> value_type
+    {
+        return value_type::from_raw( raw_.start() );
+    }
+    [[nodiscard]] constexpr auto stop() const -> value_type
+    {
+        return value_type::from_raw( raw_.stop() );
+    }
+    [[nodiscard]] constexpr auto step() const -> value_type
+    {
+        return value_type::from_raw( raw_.step() );
+    }
+    [[nodiscard]] constexpr auto raw() const -> range< rep_t, policy_t > const&
+    {   // @return the range of scaled integers, for loops that stay in integer arithmetic
+        return raw_;
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx ) const -> value_type
+    {
+        return value_type::from_raw( raw_[ idx ] );
+    }
+
+    [[nodiscard]] constexpr auto index_of( value_type const& v ) const -> std::ptrdiff_t
+    {   // @return index of 'v' or -1, exact
+        return raw_.index_of( v.raw() );
+    }
+    [[nodiscard]] constexpr auto contains( value_type const& v ) const -> bool
+    {
+        return raw_.contains( v.raw() );
+    }
+    [[nodiscard]] constexpr auto count( value_type const& v ) const -> std::size_t
+    {
+        return raw_.count( v.raw() );
+    }
+    [[nodiscard]] constexpr auto slice( std::ptrdiff_t const start, std::ptrdiff_t const stop, std::ptrdiff_t const step = 1 ) const -> range
+    {
+        return range{ raw_.slice( start, stop, step ) };
+    }
+    [[nodiscard]] constexpr auto reversed() const -> range
+    {
+        return range{ raw_.reversed() };
+    }
+
+    using iterator = detail::index_iterator< range >;
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, gsl::narrow< std::ptrdiff_t >( size() ) };
+    }
+
+private:
+    range< rep_t, policy_t > raw_;
+};
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_FIXED_H_
@@ -0,0 +1,178 @@
+// range_nd.h
+//
+// n-dimensional range, the cartesian product of one range per dimension
+// iterated row major ( last dimension fastest )
+// e.g.
+//     for ( auto const [ y, x ] : roam::ndrange{ roam::range{ h }, roam::range{ w } } ) {}
+//     for ( auto const [ z, y, x ] : roam::ndrange{ roam::range{ 4 }, roam::range{ 0, 8, 2 }, roam::range{ 3 } } ) {}
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_ND_H_
+#define _INC_ROAM_RANGE_ND_H_
+
+#include "range.h"
+
+#include <array>
+#include <utility>     // for std::index_sequence
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+namespace detail
+{
+    template < typename fn_t, std::size_t... is >
+    [[nodiscard]] constexpr auto make_array( fn_t&& fn, std::index_sequence< is... > )
+    {
+        return std::array< decltype( fn( std::size_t{} ) ), sizeof...( is ) >{ { fn( is )... } };
+    }
+
+    template < std::size_t n, typename fn_t >
+    [[nodiscard]] constexpr auto make_array( fn_t&& fn )
+    {   // @return { fn( 0 ), fn( 1 ), ... fn( n - 1 ) }, element type need not be default constructible
+        return make_array( std::forward< fn_t >( fn ), std::make_index_sequence< n >{} );
+    }
+} // detail
+
+template < typename ty_t, std::size_t dims >
+class ndrange
+{
+    static_assert( dims > 0, "ndrange requires at least one dimension" );
+
+public:
+    using value_type = std::array< ty_t, dims >;
+
+    constexpr explicit ndrange( std::array< range< ty_t >, dims > const& extents ) :
+        extents_{ extents }
+    {   // @example: ndrange< int, 2 >{ { range{ 4 }, range{ 8 } } }
+    }
+    template < typename... rs_t >
+    constexpr explicit ndrange( range< ty_t > const& r0, rs_t const&... rs ) :
+        extents_{ { r0, rs... } }
+    {   // @example: ndrange{ range{ 4 }, range{ 8 } }
+    }
+
+    [[nodiscard]] static constexpr auto rank() -> std::size_t
+    {
+        return dims;
+    }
+    [[nodiscard]] constexpr auto extent( std::size_t const d ) const -> range< ty_t > const&
+    {   // @return range of dimension 'd'
+        return extents_[ d ];
+    }
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {   // @return number of points, product of the extents' sizes
+        auto ret = std::size_t{ 1 };
+        for ( auto const& e : extents_ ) {
+            ret *= e.size();
+        }
+        return ret;
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return 0 == size();
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx_in ) const -> value_type
+    {   // @return point at row major linear index, negative indices count back from the end
+        auto idx = idx_in >= 0 ? idx_in : gsl::narrow< std::ptrdiff_t >( size() ) + idx_in;
+        auto ret = value_type{};
+        for ( auto d = dims; d-- > 0; ) {
+            auto const n = static_cast< std::ptrdiff_t >( extents_[ d ].size() );
+            ret[ d ] = extents_[ d ][ idx % n ];
+            idx /= n;
+        }
+        // @requires: valid index
+        assert( idx == 0 );
+        return ret;
+    }
+
+    // iteration
+    // @note: steps an odometer of per dimension indices, no division per element
+    class iterator
+    {   // iterator holds reference to ndrange and is invalidated if ndrange destroyed
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::array< ty_t, dims >;
+        using reference = value_type;
+        using pointer = value_type*;
+        using iterator_category = std::forward_iterator_tag;
+
+        explicit iterator( ndrange const& range, std::ptrdiff_t const& idx ) :
+            range_{ range },
+            idx_{ idx }
+        {   // only begin ( idx == 0 ) and end are constructed, the odometer starts at zero
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return &range_ == &rhs.range_ && idx_ == rhs.idx_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            ++idx_;
+            for ( auto d = dims; d-- > 0; ) {
+                if ( ++pos_[ d ] < static_cast< std::ptrdiff_t >( range_.extents_[ d ].size() ) ) {
+                    break;
+                }
+                pos_[ d ] = 0;
+            }
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() const -> reference {
+            auto ret = value_type{};
+            for ( auto d = std::size_t{ 0 }; d < dims; ++d ) {
+                ret[ d ] = range_.extents_[ d ][ pos_[ d ] ];
+            }
+            return ret;
+        }
+
+    private:
+        ndrange const& range_;
+        std::ptrdiff_t idx_{};
+        std::array< std::ptrdiff_t, dims > pos_{};
+    };
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, gsl::narrow< std::ptrdiff_t >( size() ) };
+    }
+
+private:
+    std::array< range< ty_t >, dims > extents_;
+};
+
+// construct from one range per dimension
+template < typename ty_t, typename... rs_t >
+ndrange( range< ty_t > const&, rs_t const&... ) -> ndrange< ty_t, 1 + sizeof...( rs_t ) >;
+
+template < typename ty_t >
+using ndrange2d = ndrange< ty_t, 2 >;
+
+// @utility: [ lo, hi ) sub range of a range by index, keeps the step
+template < typename ty_t >
+[[nodiscard]] constexpr auto sub_range( range< ty_t > const& r, std::ptrdiff_t const lo, std::ptrdiff_t const hi )
+{   // @example: sub_range( range{ 0, 20, 2 }, 2, 5 ) == range{ 4, 10, 2 }
+    // @requires: 0 <= lo <= hi <= r.size()
+    auto const n = gsl::narrow< std::ptrdiff_t >( r.size() );
+    assert( 0 <= lo && lo <= hi && hi <= n );
+    auto const start = lo < n ? r[ lo ] : r.stop();
+    auto const stop = hi < n ? r[ hi ] : r.stop();
+    return range< ty_t >{ start, stop, r.step() };
+}
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_ND_H_
@@ -0,0 +1,224 @@
+// range_order.h
+//
+// coarse to fine traversal orders, every prefix covers the range evenly
+// bit_reversed( r )    visits index p in bit reversed counting order, skipping p >= size.
+//                      for power of two sizes this is the fft bit reversal permutation
+// low_discrepancy( r ) visits the base 2 van der Corput sequence scaled to size, so any
+//                      prefix of m elements leaves gaps of at most ~2 * size / m
+// both are permutations of the range for any size, stepping is O(1) amortized and a loop
+// may stop at any point
+// e.g.
+//     for ( auto const i : roam::low_discrepancy( roam::range{ rows } ) ) { render_row( i ); }
+//     roam::bit_reversed( roam::range{ 1024 } ).materialize( order.data() );
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_ORDER_H_
+#define _INC_ROAM_RANGE_ORDER_H_
+
+#include "range.h"
+
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+namespace detail
+{
+    [[nodiscard]] constexpr auto reverse_bits64( std::uint64_t x ) -> std::uint64_t
+    {   // @return 'x' with bit order reversed, branch free swap ladder
+        x = ( ( x >> 1 ) & 0x5555555555555555ull ) | ( ( x & 0x5555555555555555ull ) << 1 );
+        x = ( ( x >> 2 ) & 0x3333333333333333ull ) | ( ( x & 0x3333333333333333ull ) << 2 );
+        x = ( ( x >> 4 ) & 0x0f0f0f0f0f0f0f0full ) | ( ( x & 0x0f0f0f0f0f0f0f0full ) << 4 );
+        x = ( ( x >> 8 ) & 0x00ff00ff00ff00ffull ) | ( ( x & 0x00ff00ff00ff00ffull ) << 8 );
+        x = ( ( x >> 16 ) & 0x0000ffff0000ffffull ) | ( ( x & 0x0000ffff0000ffffull ) << 16 );
+        return ( x >> 32 ) | ( x << 32 );
+    }
+
+    [[nodiscard]] constexpr auto mul_shift( std::uint64_t const a, std::uint64_t const b, int const shift ) -> std::uint64_t
+    {   // @return floor( a * b / 2^shift ) without overflow in the 128 bit product
+        // @requires: 0 < shift <= 64 and the result fits 64 bits
+        auto const lo_mask = std::uint64_t{ 0xffffffff };
+        auto const ll = ( a & lo_mask ) * ( b & lo_mask );
+        auto const lh = ( a & lo_mask ) * ( b >> 32 );
+        auto const hl = ( a >> 32 ) * ( b & lo_mask );
+        auto const hh = ( a >> 32 ) * ( b >> 32 );
+        auto const mid = ( ll >> 32 ) + ( lh & lo_mask ) + ( hl & lo_mask );
+        auto const lo = ( mid << 32 ) | ( ll & lo_mask );
+        auto const hi = hh + ( lh >> 32 ) + ( hl >> 32 ) + ( mid >> 32 );
+        return shift == 64 ? hi : ( hi << ( 64 - shift ) ) | ( lo >> shift );
+    }
+} // detail
+
+// radical inverse ( base 2 ) traversal of a range
+// counter i runs over [0, 2^bits) with 2^bits the smallest power of two >= size, p = reverse( i ).
+// scaled == false yields base[ p ] for p < size
+// scaled == true yields base[ floor( p * size / 2^bits ) ] for the first p mapping to each index
+// at least half of the counter values yield an element, so a step is O(1) amortized
+template < typename ty_t, bool scaled >
+class radical_inverse_range
+{
+public:
+    using value_type = ty_t;
+
+    constexpr explicit radical_inverse_range( range< ty_t > const& base ) :
+        base_{ base },
+        n_{ static_cast< std::uint64_t >( base.size() ) }
+    {   // @requires: size <= 2^62 so the counter can not overflow
+        assert( n_ <= ( std::uint64_t{ 1 } << 62 ) );
+        while ( ( std::uint64_t{ 1 } << bits_ ) < n_ ) {
+            ++bits_;
+        }
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return base_.size();
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return base_.empty();
+    }
+
+    void materialize( value_type* out ) const
+    {   // write all 'size()' elements to 'out' in traversal order
+        // @note: each counter value is reversed independently, for power of two sizes nothing
+        //        is skipped and the loop vectorizes
+        if ( n_ == 0 ) {
+            return;
+        }
+        auto const m = std::uint64_t{ 1 } << bits_;
+        if ( n_ == m ) {
+            for ( auto i = std::uint64_t{ 0 }; i < m; ++i ) {
+                out[ i ] = element( reverse( i ) );
+            }
+            return;
+        }
+        for ( auto i = std::uint64_t{ 0 }; i < m; ++i ) {
+            auto const p = reverse( i );
+            if ( keep( p ) ) {
+                *out++ = element( index( p ) );
+            }
+        }
+    }
+
+    class iterator
+    {   // iterator holds reference to radical_inverse_range and is invalidated if it is destroyed
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = ty_t;
+        using reference = ty_t;
+        using pointer = ty_t*;
+        using iterator_category = std::forward_iterator_tag;
+
+        explicit iterator( radical_inverse_range const& order, std::uint64_t const count ) :
+            order_{ order },
+            count_{ count }
+        {
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return &order_ == &rhs.order_ && count_ == rhs.count_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            auto const m = std::uint64_t{ 1 } << order_.bits_;
+            do {
+                if ( ++count_ == m ) {
+                    break;
+                }
+                // reversed increment, carry propagates from the top bit down
+                auto mask = m >> 1;
+                while ( ( p_ & mask ) != 0 ) {
+                    p_ ^= mask;
+                    mask >>= 1;
+                }
+                p_ |= mask;
+            } while ( !order_.keep( p_ ) );
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() const -> reference {
+            return order_.base_[ static_cast< std::ptrdiff_t >( order_.index( p_ ) ) ];
+        }
+
+    private:
+        radical_inverse_range const& order_;
+        std::uint64_t count_{};
+        std::uint64_t p_{};   // reverse( count ), 0 is always kept
+    };
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, empty() ? std::uint64_t{ 1 } << bits_ : 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, std::uint64_t{ 1 } << bits_ };
+    }
+
+private:
+    [[nodiscard]] constexpr auto reverse( std::uint64_t const i ) const -> std::uint64_t
+    {
+        return bits_ == 0 ? 0 : detail::reverse_bits64( i ) >> ( 64 - bits_ );
+    }
+    [[nodiscard]] constexpr auto index( std::uint64_t const p ) const -> std::uint64_t
+    {   // @return index into the base range for counter position 'p'
+        if constexpr ( scaled ) {
+            return bits_ == 0 ? 0 : detail::mul_shift( p, n_, bits_ );
+        }
+        else {
+            return p;
+        }
+    }
+    [[nodiscard]] constexpr auto element( std::uint64_t const idx ) const -> ty_t
+    {   // @return base_[ idx ] unchecked, modulo 2^64 for integral types as range::element
+        //         computes it, so steps times indices past the type's limits do not overflow
+        if constexpr ( std::is_integral_v< ty_t > ) {
+            return static_cast< ty_t >( static_cast< std::uint64_t >( base_.start() ) + static_cast< std::uint64_t >( base_.step() ) * idx );
+        }
+        else {
+            return static_cast< ty_t >( base_.start() + base_.step() * static_cast< ty_t >( idx ) );
+        }
+    }
+    [[nodiscard]] constexpr auto keep( std::uint64_t const p ) const -> bool
+    {
+        if constexpr ( scaled ) {
+            // keep the first position mapping to each index
+            return p == 0 || index( p ) != index( p - 1 );
+        }
+        else {
+            return p < n_;
+        }
+    }
+
+    range< ty_t > base_;
+    std::uint64_t n_{};
+    int bits_{};
+};
+
+template < typename ty_t >
+[[nodiscard]] constexpr auto bit_reversed( range< ty_t > const& r ) -> radical_inverse_range< ty_t, false >
+{   // @example: bit_reversed( range{ 8 } ) -> 0, 4, 2, 6, 1, 5, 3, 7
+    //           bit_reversed( range{ 6 } ) -> 0, 4, 2, 1, 5, 3
+    return radical_inverse_range< ty_t, false >{ r };
+}
+
+template < typename ty_t >
+[[nodiscard]] constexpr auto low_discrepancy( range< ty_t > const& r ) -> radical_inverse_range< ty_t, true >
+{   // @example: low_discrepancy( range{ 6 } ) -> 0, 3, 1, 4, 2, 5
+    return radical_inverse_range< ty_t, true >{ r };
+}
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_ORDER_H_
@@ -0,0 +1,322 @@
+// range_pairs.h
+//
+// triangular index pair ranges for all-pairs loops
+// pairs( n )          visits every ( i, j ) with 0 <= i < j < n
+// lower_triangle( n ) visits every ( row, col ) with 0 <= col <= row < n
+// e.g.
+//     for ( auto const [ i, j ] : roam::pairs( 5 ) ) {}
+//     for ( auto const [ r, c ] : roam::lower_triangle( 5 ) ) {}
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_PAIRS_H_
+#define _INC_ROAM_RANGE_PAIRS_H_
+
+#include "range.h"
+
+#include <cstdint>
+#include <utility>     // for std::pair
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+namespace detail
+{
+    [[nodiscard]] constexpr auto isqrt( std::ptrdiff_t const v ) -> std::ptrdiff_t
+    {   // @return floor( sqrt( v ) )
+        // @requires: non-negative input
+        assert( v >= 0 );
+        if ( v < 2 ) {
+            return v;
+        }
+        // newton iteration from a power of two >= sqrt( v ), converges in a handful of steps
+        auto w = static_cast< std::uint64_t >( v );
+        auto log2 = 0;
+        for ( auto s = 32; s > 0; s /= 2 ) {
+            if ( ( w >> s ) != 0 ) {
+                w >>= s;
+                log2 += s;
+            }
+        }
+        auto x = std::ptrdiff_t{ 1 } << ( log2 / 2 + 1 );
+        for ( ;; ) {
+            auto const y = ( x + v / x ) / 2;
+            if ( y >= x ) {
+                return x;
+            }
+            x = y;
+        }
+    }
+
+    [[nodiscard]] constexpr auto triangle_count( std::ptrdiff_t const rows ) -> std::ptrdiff_t
+    {   // @return number of entries in a triangle with 1, 2, ... rows entries per row
+        return rows > 0 ? rows * ( rows + 1 ) / 2 : 0;
+    }
+
+    [[nodiscard]] constexpr auto triangle_row( std::ptrdiff_t const k ) -> std::ptrdiff_t
+    {   // @return row holding linear index 'k' in a triangle with 1, 2, ... entries per row
+        // @requires: 8k + 1 fits in ptrdiff_t
+        assert( k >= 0 && k < PTRDIFF_MAX / 8 );
+        return ( isqrt( 8 * k + 1 ) - 1 ) / 2;
+    }
+} // detail
+
+// triangular range of index pairs
+// entries are laid out row by row ( row r has r + 1 entries ) so the linear index
+// of an entry is r * ( r + 1 ) / 2 + c and both directions of the mapping are O(1)
+// @note: strict == true yields ( i, j ) with i < j, i.e. ( col, row + 1 )
+//        strict == false yields ( row, col ) with col <= row
+template < typename ty_t, bool strict >
+class triangle_range
+{
+    static_assert( std::is_integral_v< ty_t >, "triangle_range requires an integral index type" );
+
+public:
+    using value_type = std::pair< ty_t, ty_t >;
+
+    constexpr explicit triangle_range( ty_t const& n ) :
+        triangle_range{ n, 0, detail::triangle_count( rows( n ) ) }
+    {   // @example: triangle_range< int, true >{ 4 }.size() == 6
+    }
+    constexpr explicit triangle_range( ty_t const& n, std::ptrdiff_t const first, std::ptrdiff_t const last ) :
+        n_{ n },
+        first_{ first },
+        last_{ last }
+    {   // sub range of linear indices [first, last) of the full triangle
+        // @requires: valid sub range
+        assert( 0 <= first_ && first_ <= last_ && last_ <= detail::triangle_count( rows( n_ ) ) );
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {   // @return number of pairs in range
+        return static_cast< std::size_t >( last_ - first_ );
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return first_ == last_;
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx_in ) const -> value_type
+    {   // @return pair at linear index, negative indices count back from the end
+        auto const idx = idx_in >= 0 ? idx_in : ( last_ - first_ ) + idx_in;
+        // @requires: valid index
+        assert( idx >= 0 && first_ + idx < last_ );
+        auto const k = first_ + idx;
+        auto const r = detail::triangle_row( k );
+        return to_pair( r, k - detail::triangle_count( r ) );
+    }
+    [[nodiscard]] constexpr auto index_of( ty_t const& a, ty_t const& b ) const -> std::ptrdiff_t
+    {   // @return linear index of a pair in this range, inverse of operator[]
+        // @example: pairs( 4 ).index_of( 1, 2 ) == 2
+        // @requires: pair is a member of the range
+        auto const r = strict ? static_cast< std::ptrdiff_t >( b ) - 1 : static_cast< std::ptrdiff_t >( a );
+        auto const c = static_cast< std::ptrdiff_t >( strict ? a : b );
+        assert( 0 <= c && c <= r && r < rows( n_ ) );
+        auto const k = detail::triangle_count( r ) + c;
+        assert( first_ <= k && k < last_ );
+        return k - first_;
+    }
+
+    [[nodiscard]] constexpr auto split( std::ptrdiff_t const part, std::ptrdiff_t const parts ) const -> triangle_range
+    {   // @return part 'part' of 'parts' equal work shares of the range
+        // @example: auto const share = pairs( n ).split( thread_id, thread_count );
+        // @requires: valid part index
+        assert( parts > 0 && 0 <= part && part < parts );
+        auto const sz = last_ - first_;
+        auto const base = sz / parts;
+        auto const extra = sz % parts;
+        auto const lo = first_ + base * part + ( part < extra ? part : extra );
+        auto const hi = lo + base + ( part < extra ? 1 : 0 );
+        return triangle_range{ n_, lo, hi };
+    }
+
+    // tiled traversal: the square [ bi*b, bi*b+b ) x [ bj*b, bj*b+b ) blocks that intersect the
+    // triangle, visited so both index blocks of a tile stay in cache for the whole tile
+    class tile
+    {
+    public:
+        constexpr explicit tile( range< ty_t > const& a, range< ty_t > const& b, bool const diag ) :
+            first{ a },
+            second{ b },
+            diagonal{ diag }
+        {
+        }
+
+        template < typename fn_t >
+        void for_each( fn_t&& fn ) const
+        {   // invoke fn( a, b ) for every pair of the tile, inner bounds are computed per row
+            // so the inner loop is branch free
+            auto const lo = second[ 0 ];
+            auto const hi = static_cast< ty_t >( lo + static_cast< ty_t >( second.size() ) );
+            for ( auto const a : first ) {
+                auto const b_lo = ( strict && diagonal ) ? static_cast< ty_t >( a + 1 ) : lo;
+                auto const b_hi = ( !strict && diagonal ) ? static_cast< ty_t >( a + 1 ) : hi;
+                for ( auto b = b_lo; b < b_hi; ++b ) {
+                    fn( a, b );
+                }
+            }
+        }
+
+        range< ty_t > first;   // i for pairs, row for lower_triangle
+        range< ty_t > second;  // j for pairs, col for lower_triangle
+        bool diagonal{};       // tile straddles the diagonal and is itself triangular
+    };
+
+    class tile_range
+    {
+    public:
+        constexpr explicit tile_range( ty_t const& n, ty_t const& b ) :
+            n_{ n },
+            b_{ b },
+            blocks_{ static_cast< ty_t >( ( n + b - 1 ) / b ) }
+        {   // @requires: positive tile size
+            assert( b_ > ty_t{ 0 } );
+        }
+
+        [[nodiscard]] constexpr auto size() const -> std::size_t
+        {
+            return blocks_.size();
+        }
+        [[nodiscard]] constexpr auto empty() const -> bool
+        {
+            return blocks_.empty();
+        }
+        [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx ) const -> tile
+        {
+            auto const [ hi, lo ] = blocks_[ idx ];
+            auto const diagonal = ( hi == lo );
+            return strict ? tile{ block( lo ), block( hi ), diagonal } : tile{ block( hi ), block( lo ), diagonal };
+        }
+
+        using iterator = detail::index_iterator< tile_range >;
+
+        [[nodiscard]] auto begin() const -> iterator {
+            return iterator{ *this, 0 };
+        }
+        [[nodiscard]] auto end() const -> iterator {
+            return iterator{ *this, static_cast< std::ptrdiff_t >( size() ) };
+        }
+
+    private:
+        [[nodiscard]] constexpr auto block( ty_t const& idx ) const -> range< ty_t >
+        {
+            auto const lo = static_cast< ty_t >( idx * b_ );
+            auto const hi = static_cast< ty_t >( n_ - lo < b_ ? n_ : lo + b_ );
+            return range< ty_t >{ lo, hi };
+        }
+
+        ty_t n_{};
+        ty_t b_{};
+        triangle_range< ty_t, false > blocks_;   // ( hi, lo ) block index pairs, lo <= hi
+    };
+
+    [[nodiscard]] constexpr auto tiles( ty_t const& b ) const -> tile_range
+    {   // @return b x b tiles covering the full triangle ( sub ranges from split are ignored )
+        // @example: for ( auto const& t : pairs( n ).tiles( 64 ) ) t.for_each( kernel );
+        return tile_range{ n_, b };
+    }
+
+    // iteration
+    // @note: steps the ( row, col ) pair directly, no square root per element
+    class iterator
+    {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::pair< ty_t, ty_t >;
+        using reference = value_type;
+        using pointer = value_type*;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        explicit iterator( std::ptrdiff_t const k ) :
+            k_{ k },
+            row_{ detail::triangle_row( k ) },
+            col_{ k - detail::triangle_count( row_ ) }
+        {
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return k_ == rhs.k_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            ++k_;
+            if ( ++col_ > row_ ) {
+                col_ = 0;
+                ++row_;
+            }
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            ++*this;
+            return ret;
+        }
+        auto operator--() -> iterator& {
+            --k_;
+            if ( col_-- == 0 ) {
+                --row_;
+                col_ = row_;
+            }
+            return *this;
+        }
+        auto operator--( int ) -> iterator {
+            auto const ret = *this;
+            --*this;
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() const -> reference {
+            return to_pair( row_, col_ );
+        }
+
+    private:
+        std::ptrdiff_t k_{};
+        std::ptrdiff_t row_{};
+        std::ptrdiff_t col_{};
+    };
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ first_ };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ last_ };
+    }
+
+private:
+    [[nodiscard]] static constexpr auto rows( ty_t const& n ) -> std::ptrdiff_t
+    {   // number of rows of the underlying triangle
+        return strict ? static_cast< std::ptrdiff_t >( n ) - 1 : static_cast< std::ptrdiff_t >( n );
+    }
+    [[nodiscard]] static constexpr auto to_pair( std::ptrdiff_t const r, std::ptrdiff_t const c ) -> value_type
+    {
+        return strict ? value_type{ static_cast< ty_t >( c ), static_cast< ty_t >( r + 1 ) }
+                      : value_type{ static_cast< ty_t >( r ), static_cast< ty_t >( c ) };
+    }
+
+    ty_t n_{};
+    std::ptrdiff_t first_{};
+    std::ptrdiff_t last_{};
+};
+
+template < typename ty_t >
+[[nodiscard]] constexpr auto pairs( ty_t const& n )
+{   // @return all ( i, j ) with 0 <= i < j < n, ordered by j then i
+    // @example: pairs( 3 ) -> ( 0, 1 ), ( 0, 2 ), ( 1, 2 )
+    return triangle_range< ty_t, true >{ n };
+}
+
+template < typename ty_t >
+[[nodiscard]] constexpr auto lower_triangle( ty_t const& n )
+{   // @return all ( row, col ) with 0 <= col <= row < n, ordered by row then col
+    // @example: lower_triangle( 2 ) -> ( 0, 0 ), ( 1, 0 ), ( 1, 1 )
+    return triangle_range< ty_t, false >{ n };
+}
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_PAIRS_H_
@@ -0,0 +1,334 @@
+// range_pointer.h
+//
+// ranges over memory: pointers with a step in elements or in bytes, and random access
+// iterators with a step in elements. elements are yielded by reference
+// contiguous() reports a unit element step so callers can switch to memcpy or simd loads
+// e.g.
+//     for ( auto& x : roam::range{ xs, xs + n, 2 } ) {}                           // every other float
+//     for ( auto& p : roam::range{ &verts[ 0 ].pos, n, roam::byte_stride{ sizeof( vertex ) } } ) {}
+//     for ( auto& v : roam::strided( vec.begin(), vec.end(), 3 ) ) {}
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_POINTER_H_
+#define _INC_ROAM_RANGE_POINTER_H_
+
+#include "range.h"
+
+#include <cstring>     // for memcpy in copy_to
+#include <iterator>
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+// step given in bytes, for interleaved records
+struct byte_stride
+{
+    std::ptrdiff_t bytes{};
+};
+
+namespace detail
+{
+    // true for iterators known to address contiguous memory
+    template < typename it_t >
+    [[nodiscard]] constexpr auto contiguous_iterator() -> bool
+    {
+#if __cplusplus >= 202002L
+        return std::contiguous_iterator< it_t >;
+#else
+        return std::is_pointer_v< it_t >;
+#endif
+    }
+
+    template < typename policy_t >
+    [[nodiscard]] constexpr auto strided_count( std::ptrdiff_t const dist, std::ptrdiff_t const step ) -> std::size_t
+    {   // @return elements in a distance walked by 'step', python range rules
+        auto const valid = step != 0 && ( dist == 0 || ( dist > 0 ) == ( step > 0 ) );
+        if constexpr ( std::is_same_v< policy_t, checking::saturating > ) {
+            // invalid ranges are empty
+            if ( !valid ) {
+                return 0;
+            }
+        }
+        else {
+            // @requires: non-zero step size
+            detail::require< policy_t, invalid_range_error >( step != 0, "range step is zero" );
+            // @requires: step in the direction of the distance
+            detail::require< policy_t, invalid_range_error >( valid, "range stop is behind start for the step direction" );
+        }
+        return static_cast< std::size_t >( step > 0 ? ( dist + step - 1 ) / step : ( dist + step + 1 ) / step );
+    }
+} // detail
+
+// range of pointers, element i lives 'i * stride' bytes after the first
+template < typename ty_t, typename policy_t >
+class range< ty_t*, policy_t >
+{
+    using byte_t = std::conditional_t< std::is_const_v< ty_t >, unsigned char const, unsigned char >;
+
+public:
+    using value_type = std::remove_cv_t< ty_t >;
+    using reference = ty_t&;
+    using pointer = ty_t*;
+    using policy_type = policy_t;
+
+    explicit range( ty_t* const first, ty_t* const last, std::ptrdiff_t const step = 1 ) :
+        first_{ reinterpret_cast< byte_t* >( first ) },
+        stride_{ step * static_cast< std::ptrdiff_t >( sizeof( ty_t ) ) },
+        size_{ detail::strided_count< policy_t >( last - first, step ) }
+    {   // @example: range{ p, p + 10, 3 } -> p[ 0 ], p[ 3 ], p[ 6 ], p[ 9 ]
+    }
+    explicit range( ty_t* const first, std::size_t const count, byte_stride const stride ) :
+        first_{ reinterpret_cast< byte_t* >( first ) },
+        stride_{ stride.bytes },
+        size_{ count }
+    {   // @example: range{ &verts[ 0 ].normal, verts.size(), byte_stride{ sizeof( vertex ) } }
+        // @requires: every element stays aligned
+        detail::require< policy_t, invalid_range_error >( stride_ % static_cast< std::ptrdiff_t >( alignof( ty_t ) ) == 0, "byte stride misaligns the elements" );
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return size_;
+    }
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return 0 == size_;
+    }
+    [[nodiscard]] auto stride() const -> std::ptrdiff_t
+    {   // @return distance between elements in bytes
+        return stride_;
+    }
+    [[nodiscard]] auto contiguous() const -> bool
+    {   // @return true when elements are adjacent and ascending, i.e. a plain array of size() elements
+        return stride_ == static_cast< std::ptrdiff_t >( sizeof( ty_t ) );
+    }
+    [[nodiscard]] auto data() const -> pointer
+    {   // @return pointer to the first element, an array of size() elements when contiguous()
+        return reinterpret_cast< pointer >( first_ );
+    }
+    [[nodiscard]] auto operator[]( std::ptrdiff_t const idx_in ) const -> reference
+    {
+        auto const n = static_cast< std::ptrdiff_t >( size_ );
+        auto idx = idx_in >= 0 ? idx_in : n + idx_in;
+        if constexpr ( std::is_same_v< policy_t, checking::saturating > ) {
+            idx = idx >= n ? n - 1 : idx;
+            idx = idx < 0 ? 0 : idx;
+        }
+        else if constexpr ( !std::is_same_v< policy_t, checking::unchecked > && !std::is_same_v< policy_t, checking::validated > ) {
+            // @requires: valid index
+            detail::require< policy_t, out_of_range_error >( 0 <= idx && idx < n, "range index out of range" );
+        }
+        return *reinterpret_cast< pointer >( first_ + idx * stride_ );
+    }
+
+    void copy_to( value_type* out ) const
+    {   // gather all elements into 'out', a single memcpy when contiguous
+        static_assert( std::is_trivially_copyable_v< value_type >, "copy_to is for trivially copyable elements" );
+        if ( contiguous() ) {
+            std::memcpy( out, data(), size_ * sizeof( ty_t ) );
+            return;
+        }
+        for ( auto i = std::size_t{ 0 }; i < size_; ++i ) {
+            std::memcpy( out + i, first_ + static_cast< std::ptrdiff_t >( i ) * stride_, sizeof( ty_t ) );
+        }
+    }
+
+    // iteration, by reference
+    class iterator
+    {   // iterator holds reference to range and is invalidated if range destroyed
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::remove_cv_t< ty_t >;
+        using reference = ty_t&;
+        using pointer = ty_t*;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        explicit iterator( range const& r, std::ptrdiff_t const& idx ) :
+            range_{ &r },
+            idx_{ idx }
+        {
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return range_ == rhs.range_ && idx_ == rhs.idx_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            ++idx_;
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            ++idx_;
+            return ret;
+        }
+        auto operator--() -> iterator& {
+            --idx_;
+            return *this;
+        }
+        auto operator--( int ) -> iterator {
+            auto const ret = *this;
+            --idx_;
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() const -> reference {
+            return ( *range_ )[ idx_ ];
+        }
+        [[nodiscard]] auto operator->() const -> pointer {
+            return &( *range_ )[ idx_ ];
+        }
+
+    private:
+        range const* range_{};
+        std::ptrdiff_t idx_{};
+    };
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, static_cast< std::ptrdiff_t >( size_ ) };
+    }
+
+private:
+    byte_t* first_{};
+    std::ptrdiff_t stride_{};   // in bytes, may be negative
+    std::size_t size_{};
+};
+
+template < typename ty_t >
+range( ty_t*, ty_t*, std::ptrdiff_t = 1 ) -> range< ty_t* >;
+template < typename ty_t >
+range( ty_t*, std::size_t, byte_stride ) -> range< ty_t* >;
+
+// random access iterator range with a step in elements
+template < typename it_t, typename policy_t = checking::asserted >
+class iterator_range
+{
+    static_assert( std::is_base_of_v< std::random_access_iterator_tag, typename std::iterator_traits< it_t >::iterator_category >,
+                   "iterator_range requires random access iterators" );
+
+public:
+    using value_type = typename std::iterator_traits< it_t >::value_type;
+    using reference = typename std::iterator_traits< it_t >::reference;
+    using policy_type = policy_t;
+
+    explicit iterator_range( it_t const first, it_t const last, std::ptrdiff_t const step = 1 ) :
+        first_{ first },
+        step_{ step },
+        size_{ detail::strided_count< policy_t >( static_cast< std::ptrdiff_t >( last - first ), step ) }
+    {   // @example: iterator_range{ v.begin(), v.end(), 2 }
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return size_;
+    }
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return 0 == size_;
+    }
+    [[nodiscard]] auto step() const -> std::ptrdiff_t
+    {
+        return step_;
+    }
+    [[nodiscard]] auto contiguous() const -> bool
+    {   // @return true when the elements are known to be one array ( pointers, or c++20 contiguous iterators )
+        return step_ == 1 && detail::contiguous_iterator< it_t >();
+    }
+    [[nodiscard]] auto operator[]( std::ptrdiff_t const idx_in ) const -> reference
+    {
+        auto const n = static_cast< std::ptrdiff_t >( size_ );
+        auto idx = idx_in >= 0 ? idx_in : n + idx_in;
+        if constexpr ( std::is_same_v< policy_t, checking::saturating > ) {
+            idx = idx >= n ? n - 1 : idx;
+            idx = idx < 0 ? 0 : idx;
+        }
+        else if constexpr ( !std::is_same_v< policy_t, checking::unchecked > && !std::is_same_v< policy_t, checking::validated > ) {
+            // @requires: valid index
+            detail::require< policy_t, out_of_range_error >( 0 <= idx && idx < n, "range index out of range" );
+        }
+        return first_[ idx * step_ ];
+    }
+
+    class iterator
+    {   // iterator holds reference to iterator_range and is invalidated if it is destroyed
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = typename std::iterator_traits< it_t >::value_type;
+        using reference = typename std::iterator_traits< it_t >::reference;
+        using pointer = typename std::iterator_traits< it_t >::pointer;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        explicit iterator( iterator_range const& r, std::ptrdiff_t const& idx ) :
+            range_{ &r },
+            idx_{ idx }
+        {
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return range_ == rhs.range_ && idx_ == rhs.idx_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            ++idx_;
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            ++idx_;
+            return ret;
+        }
+        auto operator--() -> iterator& {
+            --idx_;
+            return *this;
+        }
+        auto operator--( int ) -> iterator {
+            auto const ret = *this;
+            --idx_;
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() const -> reference {
+            return ( *range_ )[ idx_ ];
+        }
+
+    private:
+        iterator_range const* range_{};
+        std::ptrdiff_t idx_{};
+    };
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, static_cast< std::ptrdiff_t >( size_ ) };
+    }
+
+private:
+    it_t first_{};
+    std::ptrdiff_t step_{};
+    std::size_t size_{};
+};
+
+template < typename it_t >
+[[nodiscard]] auto strided( it_t const first, it_t const last, std::ptrdiff_t const step = 1 ) -> iterator_range< it_t >
+{   // @return every 'step'th element of [first, last)
+    // @example: strided( v.begin(), v.end(), 3 ) -> v[ 0 ], v[ 3 ], ...
+    return iterator_range< it_t >{ first, last, step };
+}
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_POINTER_H_
@@ -0,0 +1,472 @@
+// range_random.h
+//
+// randomized traversal of a range without materializing it
+// shuffled( r, seed ) visits every element of 'r' exactly once in a pseudo-random order,
+// the order is a keyed bijection on [0, size) so state and random access are both O(1)
+// sample_bernoulli( r, p, seed ) and sample_k( r, k, seed ) lazily yield a random subset
+// in range order, drawing one skip length per selected element rather than one coin per element
+// e.g.
+//     for ( auto const i : roam::shuffled( roam::range< int64_t >{ 10'000'000'000 }, seed ) ) {}
+//     auto const v = roam::shuffled( roam::range{ 100 }, seed )[ 42 ];
+//     for ( auto const i : roam::sample_bernoulli( roam::range< int64_t >{ events }, 0.001, seed ) ) {}
+//     for ( auto const i : roam::sample_k( roam::range< int64_t >{ events }, 1000, seed ) ) {}
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_RANDOM_H_
+#define _INC_ROAM_RANGE_RANDOM_H_
+
+#include "range.h"
+
+#include <cmath>       // for log / exp in the sampling skip distributions
+#include <cstdint>
+#include <iterator>
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+namespace detail
+{
+    [[nodiscard]] constexpr auto splitmix64( std::uint64_t x ) -> std::uint64_t
+    {   // @return well mixed 64 bit hash of 'x' ( splitmix64 finalizer )
+        x += 0x9e3779b97f4a7c15ull;
+        x = ( x ^ ( x >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+        x = ( x ^ ( x >> 27 ) ) * 0x94d049bb133111ebull;
+        return x ^ ( x >> 31 );
+    }
+
+    // small splitmix64 generator, 8 bytes of state so sampling iterators stay cheap to copy
+    class random_bits
+    {
+    public:
+        constexpr explicit random_bits( std::uint64_t const seed ) :
+            state_{ seed }
+        {
+        }
+
+        constexpr auto next() -> std::uint64_t
+        {
+            auto const x = state_;
+            state_ += 0x9e3779b97f4a7c15ull;
+            return splitmix64( x );
+        }
+        constexpr auto uniform() -> double
+        {   // @return uniform double in ( 0, 1 ], never 0 so log() is always finite
+            return static_cast< double >( ( next() >> 11 ) + 1 ) * 0x1.0p-53;
+        }
+
+    private:
+        std::uint64_t state_{};
+    };
+
+    // keyed bijection on [0, n)
+    // a balanced feistel network permutes the smallest even-bit power of two >= n, values
+    // landing outside [0, n) are encrypted again ( cycle walking ) until they fall inside.
+    // the domain is < 4n so on average fewer than 4 rounds of walking are needed
+    class feistel_permutation
+    {
+    public:
+        static auto constexpr rounds = 4;
+
+        constexpr explicit feistel_permutation( std::uint64_t const n, std::uint64_t const seed ) :
+            n_{ n }
+        {
+            auto bits = 0;
+            while ( bits < 64 && ( std::uint64_t{ 1 } << bits ) < n ) {
+                ++bits;
+            }
+            half_bits_ = bits < 2 ? 1 : ( bits + 1 ) / 2;
+            mask_ = ( std::uint64_t{ 1 } << half_bits_ ) - 1;
+            auto k = seed;
+            for ( auto& key : keys_ ) {
+                key = splitmix64( k++ );
+            }
+        }
+
+        [[nodiscard]] constexpr auto size() const -> std::uint64_t
+        {
+            return n_;
+        }
+        [[nodiscard]] constexpr auto operator()( std::uint64_t x ) const -> std::uint64_t
+        {   // @return image of 'x' under the permutation
+            // @requires: x in [0, n)
+            assert( x < n_ );
+            do {
+                x = encrypt( x );
+            } while ( x >= n_ );
+            return x;
+        }
+
+    private:
+        [[nodiscard]] constexpr auto encrypt( std::uint64_t const x ) const -> std::uint64_t
+        {
+            auto l = x >> half_bits_;
+            auto r = x & mask_;
+            for ( auto const key : keys_ ) {
+                auto const t = l ^ ( splitmix64( r ^ key ) & mask_ );
+                l = r;
+                r = t;
+            }
+            return ( l << half_bits_ ) | r;
+        }
+
+        std::uint64_t n_{};
+        int half_bits_{};
+        std::uint64_t mask_{};
+        std::uint64_t keys_[ rounds ]{};
+    };
+} // detail
+
+// pseudo-random permutation of a range
+// element idx is base[ p( idx ) ] where p is a keyed bijection of the indices, the same
+// seed always gives the same order
+template < typename ty_t >
+class shuffled_range
+{
+public:
+    using value_type = ty_t;
+
+    constexpr explicit shuffled_range( range< ty_t > const& base, std::uint64_t const seed ) :
+        base_{ base },
+        perm_{ base.size(), seed }
+    {
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return base_.size();
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return base_.empty();
+    }
+    [[nodiscard]] constexpr auto index( std::ptrdiff_t const idx ) const -> std::ptrdiff_t
+    {   // @return index into the base range visited at position 'idx'
+        auto const i = idx >= 0 ? idx : gsl::narrow< std::ptrdiff_t >( size() ) + idx;
+        return static_cast< std::ptrdiff_t >( perm_( static_cast< std::uint64_t >( i ) ) );
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx ) const -> value_type
+    {
+        return base_[ index( idx ) ];
+    }
+
+    using iterator = detail::index_iterator< shuffled_range >;
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, gsl::narrow< std::ptrdiff_t >( size() ) };
+    }
+
+private:
+    range< ty_t > base_;
+    detail::feistel_permutation perm_;
+};
+
+template < typename ty_t >
+[[nodiscard]] constexpr auto shuffled( range< ty_t > const& r, std::uint64_t const seed ) -> shuffled_range< ty_t >
+{   // @return every element of 'r' once, in a pseudo-random order keyed by 'seed'
+    // @example: shuffled( range{ 5 }, 1 ) -> some order of 0, 1, 2, 3, 4
+    return shuffled_range< ty_t >{ r, seed };
+}
+
+// bernoulli sample: every element is kept independently with probability p
+// the gap to the next kept element is geometric, so one random number is drawn per kept
+// element rather than per element. forward only, the sample size is unknown until iterated
+template < typename ty_t >
+class bernoulli_sample_range
+{
+public:
+    using value_type = ty_t;
+
+    explicit bernoulli_sample_range( range< ty_t > const& base, double const p, std::uint64_t const seed ) :
+        base_{ base },
+        p_{ p },
+        log_q_{ std::log1p( -p ) },
+        seed_{ seed }
+    {   // @requires: valid probability
+        assert( 0.0 <= p && p <= 1.0 );
+    }
+
+    class iterator
+    {   // iterator holds reference to bernoulli_sample_range and is invalidated if it is destroyed
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = ty_t;
+        using reference = ty_t;
+        using pointer = ty_t*;
+        using iterator_category = std::forward_iterator_tag;
+
+        explicit iterator( bernoulli_sample_range const& sample, std::ptrdiff_t const& idx ) :
+            sample_{ sample },
+            rng_{ sample.seed_ },
+            idx_{ idx }
+        {
+            if ( idx_ < 0 ) {
+                advance();
+            }
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return &sample_ == &rhs.sample_ && idx_ == rhs.idx_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            advance();
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            advance();
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() const -> reference {
+            return sample_.base_[ idx_ ];
+        }
+
+    private:
+        void advance()
+        {   // skip a geometric( p ) number of elements, floor( log( u ) / log( 1 - p ) )
+            auto const n = gsl::narrow< std::ptrdiff_t >( sample_.base_.size() );
+            auto const left = n - 1 - idx_;
+            if ( left <= 0 || sample_.p_ <= 0.0 ) {
+                idx_ = n;
+                return;
+            }
+            auto const gap = sample_.p_ >= 1.0 ? 0.0 : std::floor( std::log( rng_.uniform() ) / sample_.log_q_ );
+            idx_ = gap < static_cast< double >( left ) ? idx_ + 1 + static_cast< std::ptrdiff_t >( gap ) : n;
+        }
+
+        bernoulli_sample_range const& sample_;
+        detail::random_bits rng_;
+        std::ptrdiff_t idx_{};
+    };
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, -1 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, gsl::narrow< std::ptrdiff_t >( base_.size() ) };
+    }
+
+private:
+    range< ty_t > base_;
+    double p_{};
+    double log_q_{};   // log( 1 - p )
+    std::uint64_t seed_{};
+};
+
+// fixed size sample: exactly k distinct elements, every k-subset equally likely
+// sequential sampling with vitter's method D ( "an efficient algorithm for sequential random
+// sampling", 1987 ) draws each skip in O(1) expected time, falling back to method A once
+// k is no longer small relative to the remaining elements
+template < typename ty_t >
+class fixed_sample_range
+{
+public:
+    using value_type = ty_t;
+
+    // method D pays off while remaining elements > threshold * remaining samples
+    static auto constexpr threshold = std::ptrdiff_t{ 13 };
+
+    explicit fixed_sample_range( range< ty_t > const& base, std::ptrdiff_t const k, std::uint64_t const seed ) :
+        base_{ base },
+        k_{ k },
+        seed_{ seed }
+    {   // @requires: 0 <= k <= size
+        assert( 0 <= k && k <= gsl::narrow< std::ptrdiff_t >( base.size() ) );
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return static_cast< std::size_t >( k_ );
+    }
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return 0 == k_;
+    }
+
+    class iterator
+    {   // iterator holds reference to fixed_sample_range and is invalidated if it is destroyed
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = ty_t;
+        using reference = ty_t;
+        using pointer = ty_t*;
+        using iterator_category = std::forward_iterator_tag;
+
+        explicit iterator( fixed_sample_range const& sample, std::ptrdiff_t const& idx ) :
+            sample_{ sample },
+            rng_{ sample.seed_ },
+            idx_{ idx },
+            samples_{ sample.k_ },
+            records_{ gsl::narrow< std::ptrdiff_t >( sample.base_.size() ) }
+        {
+            if ( idx_ < 0 ) {
+                advance();
+            }
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return &sample_ == &rhs.sample_ && idx_ == rhs.idx_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            advance();
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            advance();
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() const -> reference {
+            return sample_.base_[ idx_ ];
+        }
+
+    private:
+        void advance()
+        {
+            if ( samples_ == 0 ) {
+                idx_ = gsl::narrow< std::ptrdiff_t >( sample_.base_.size() );
+                return;
+            }
+            auto const s = skip();
+            idx_ += s + 1;
+            records_ -= s + 1;
+            --samples_;
+        }
+
+        [[nodiscard]] auto skip() -> std::ptrdiff_t
+        {   // @return number of records to pass over before the next selected one
+            if ( samples_ == 1 ) {
+                auto const s = static_cast< std::ptrdiff_t >( static_cast< double >( records_ ) * rng_.uniform() );
+                return s < records_ ? s : records_ - 1;
+            }
+            if ( threshold * samples_ < records_ ) {
+                return skip_d();
+            }
+            vprime_ = 0.0;
+            return skip_a();
+        }
+
+        [[nodiscard]] auto skip_a() -> std::ptrdiff_t
+        {   // method A: walk the skip distribution one record at a time
+            auto top = static_cast< double >( records_ - samples_ );
+            auto left = static_cast< double >( records_ );
+            auto const v = rng_.uniform();
+            auto s = std::ptrdiff_t{ 0 };
+            auto quot = top / left;
+            while ( quot > v ) {
+                ++s;
+                top -= 1.0;
+                left -= 1.0;
+                quot = quot * top / left;
+            }
+            return s;
+        }
+
+        [[nodiscard]] auto skip_d() -> std::ptrdiff_t
+        {   // method D: rejection sampling of the skip against a continuous envelope
+            auto const n = static_cast< double >( samples_ );
+            auto const big_n = static_cast< double >( records_ );
+            auto const ninv = 1.0 / n;
+            auto const nmin1inv = 1.0 / ( n - 1.0 );
+            auto const qu1 = records_ - samples_ + 1;
+            auto const qu1_real = static_cast< double >( qu1 );
+            if ( vprime_ <= 0.0 ) {
+                vprime_ = std::exp( std::log( rng_.uniform() ) * ninv );
+            }
+            for ( ;; ) {
+                auto x = 0.0;
+                auto s = std::ptrdiff_t{ 0 };
+                for ( ;; ) {
+                    x = big_n * ( 1.0 - vprime_ );
+                    s = static_cast< std::ptrdiff_t >( x );
+                    if ( s < qu1 ) {
+                        break;
+                    }
+                    vprime_ = std::exp( std::log( rng_.uniform() ) * ninv );
+                }
+                auto const y1 = std::exp( std::log( rng_.uniform() * big_n / qu1_real ) * nmin1inv );
+                vprime_ = y1 * ( 1.0 - x / big_n ) * ( qu1_real / ( qu1_real - static_cast< double >( s ) ) );
+                if ( vprime_ <= 1.0 ) {
+                    // quick accept, vprime is reused as the next variate
+                    return s;
+                }
+                // exact test
+                auto y2 = 1.0;
+                auto top = big_n - 1.0;
+                auto bottom = 0.0;
+                auto limit = std::ptrdiff_t{ 0 };
+                if ( samples_ - 1 > s ) {
+                    bottom = big_n - n;
+                    limit = records_ - s;
+                }
+                else {
+                    bottom = big_n - 1.0 - static_cast< double >( s );
+                    limit = qu1;
+                }
+                for ( auto t = records_ - 1; t >= limit; --t ) {
+                    y2 = y2 * top / bottom;
+                    top -= 1.0;
+                    bottom -= 1.0;
+                }
+                if ( big_n / ( big_n - x ) >= y1 * std::exp( std::log( y2 ) * nmin1inv ) ) {
+                    vprime_ = std::exp( std::log( rng_.uniform() ) * nmin1inv );
+                    return s;
+                }
+                vprime_ = std::exp( std::log( rng_.uniform() ) * ninv );
+            }
+        }
+
+        fixed_sample_range const& sample_;
+        detail::random_bits rng_;
+        std::ptrdiff_t idx_{};
+        std::ptrdiff_t samples_{};   // still to select
+        std::ptrdiff_t records_{};   // after the current one
+        double vprime_{};            // carried method D variate, 0 when not yet drawn
+    };
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, -1 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, gsl::narrow< std::ptrdiff_t >( base_.size() ) };
+    }
+
+private:
+    range< ty_t > base_;
+    std::ptrdiff_t k_{};
+    std::uint64_t seed_{};
+};
+
+template < typename ty_t >
+[[nodiscard]] auto sample_bernoulli( range< ty_t > const& r, double const p, std::uint64_t const seed ) -> bernoulli_sample_range< ty_t >
+{   // @return each element of 'r' with probability 'p', in range order
+    // @example: sample_bernoulli( range< int64_t >{ 1'000'000'000 }, 0.001, seed ) -> ~1'000'000 elements
+    return bernoulli_sample_range< ty_t >{ r, p, seed };
+}
+
+template < typename ty_t >
+[[nodiscard]] auto sample_k( range< ty_t > const& r, std::ptrdiff_t const k, std::uint64_t const seed ) -> fixed_sample_range< ty_t >
+{   // @return 'k' distinct elements of 'r' chosen uniformly, in range order
+    // @example: sample_k( range{ 100 }, 5, seed ) -> e.g. 7, 31, 32, 60, 94
+    return fixed_sample_range< ty_t >{ r, k, seed };
+}
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_RANDOM_H_
@@ -0,0 +1,333 @@
+// range_set.h
+//
+// sorted set of disjoint, non-adjacent [start, stop) intervals
+// stored as one flat sorted vector of boundaries { start0, stop0, start1, stop1, ... }
+// so membership is a single binary search and set algebra is a linear merge
+// e.g.
+//     auto s = roam::range_set< int64_t >{};
+//     s.insert( roam::range< int64_t >{ 0, 100 } );
+//     s.erase( 10, 20 );
+//     for ( auto const v : s ) {}                  // 0..9, 20..99
+//     for ( auto const r : s.intervals() ) {}      // range{ 0, 10 }, range{ 20, 100 }
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_SET_H_
+#define _INC_ROAM_RANGE_SET_H_
+
+#include "range.h"
+
+#include <algorithm>   // for lower_bound / upper_bound
+#include <initializer_list>
+#include <limits>
+#include <utility>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+template < typename ty_t >
+class range_set
+{
+    static_assert( std::is_integral_v< ty_t >, "range_set requires an integral value type" );
+
+public:
+    using value_type = ty_t;
+
+    range_set() = default;
+    range_set( std::initializer_list< range< ty_t > > const rs )
+    {   // @example: range_set< int >{ range{ 0, 4 }, range{ 8, 12 } }
+        for ( auto const& r : rs ) {
+            insert( r );
+        }
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {   // @return number of values in the set, O(intervals)
+        // @note: lengths are taken in the unsigned type, an interval may span more than ty_t holds
+        auto ret = std::size_t{ 0 };
+        for ( auto i = std::size_t{ 0 }; i < bounds_.size(); i += 2 ) {
+            ret += static_cast< std::size_t >( detail::abs_diff( bounds_[ i + 1 ], bounds_[ i ] ) );
+        }
+        return ret;
+    }
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return bounds_.empty();
+    }
+    [[nodiscard]] auto contains( ty_t const& v ) const -> bool
+    {   // @return true if 'v' is in the set, O(log intervals)
+        // inside an interval exactly when an odd number of boundaries are <= v
+        return ( upper( v ) & 1 ) != 0;
+    }
+    [[nodiscard]] auto contains( range< ty_t > const& r ) const -> bool
+    {   // @return true if every value of a unit step range is in the set
+        if ( r.empty() ) {
+            return true;
+        }
+        auto const [ lo, hi ] = bounds( r );
+        auto const p = upper( lo );
+        return ( p & 1 ) != 0 && hi <= bounds_[ p ];
+    }
+
+    void insert( ty_t const& v )
+    {   // @requires: v below the type's maximum, intervals are half open so it is never a member
+        assert( v != std::numeric_limits< ty_t >::max() );
+        if ( v != std::numeric_limits< ty_t >::max() ) {
+            insert( v, static_cast< ty_t >( v + 1 ) );
+        }
+    }
+    void insert( range< ty_t > const& r )
+    {
+        if ( !r.empty() ) {
+            auto const [ lo, hi ] = bounds( r );
+            insert( lo, hi );
+        }
+    }
+    void insert( ty_t const& lo, ty_t const& hi )
+    {   // add [lo, hi), coalescing with overlapping and adjacent intervals
+        // @requires: valid interval
+        assert( lo <= hi );
+        if ( lo == hi ) {
+            return;
+        }
+        // a boundary before 'lo' that is a start means 'lo' falls in ( or touches ) that interval
+        auto const p = lower( lo );
+        auto const q = upper( hi );
+        replace( p, q, ( p & 1 ) == 0, lo, ( q & 1 ) == 0, hi );
+    }
+
+    void erase( ty_t const& v )
+    {   // @note: the type's maximum is never a member, erasing it does nothing
+        if ( v != std::numeric_limits< ty_t >::max() ) {
+            erase( v, static_cast< ty_t >( v + 1 ) );
+        }
+    }
+    void erase( range< ty_t > const& r )
+    {
+        if ( !r.empty() ) {
+            auto const [ lo, hi ] = bounds( r );
+            erase( lo, hi );
+        }
+    }
+    void erase( ty_t const& lo, ty_t const& hi )
+    {   // remove [lo, hi), splitting intervals as needed
+        // @requires: valid interval
+        assert( lo <= hi );
+        if ( lo == hi ) {
+            return;
+        }
+        auto const p = lower( lo );
+        auto const q = upper( hi );
+        replace( p, q, ( p & 1 ) != 0, lo, ( q & 1 ) != 0, hi );
+    }
+    void clear()
+    {
+        bounds_.clear();
+    }
+
+    // intervals, each as a unit step range
+    class interval_view
+    {
+    public:
+        using value_type = range< ty_t >;
+
+        explicit interval_view( range_set const& set ) :
+            set_{ set }
+        {
+        }
+
+        [[nodiscard]] auto size() const -> std::size_t
+        {
+            return set_.bounds_.size() / 2;
+        }
+        [[nodiscard]] auto empty() const -> bool
+        {
+            return set_.bounds_.empty();
+        }
+        [[nodiscard]] auto operator[]( std::ptrdiff_t const idx_in ) const -> value_type
+        {
+            auto const idx = idx_in >= 0 ? idx_in : static_cast< std::ptrdiff_t >( size() ) + idx_in;
+            return value_type{ set_.bounds_[ 2 * idx ], set_.bounds_[ 2 * idx + 1 ] };
+        }
+
+        using iterator = detail::index_iterator< interval_view >;
+
+        [[nodiscard]] auto begin() const -> iterator {
+            return iterator{ *this, 0 };
+        }
+        [[nodiscard]] auto end() const -> iterator {
+            return iterator{ *this, static_cast< std::ptrdiff_t >( size() ) };
+        }
+
+    private:
+        range_set const& set_;
+    };
+
+    [[nodiscard]] auto intervals() const -> interval_view
+    {
+        return interval_view{ *this };
+    }
+
+    // set algebra, linear in the number of intervals of both sets
+    [[nodiscard]] friend auto operator|( range_set const& a, range_set const& b ) -> range_set
+    {
+        return merge( a, b, []( bool const x, bool const y ) { return x || y; } );
+    }
+    [[nodiscard]] friend auto operator&( range_set const& a, range_set const& b ) -> range_set
+    {
+        return merge( a, b, []( bool const x, bool const y ) { return x && y; } );
+    }
+    [[nodiscard]] friend auto operator-( range_set const& a, range_set const& b ) -> range_set
+    {
+        return merge( a, b, []( bool const x, bool const y ) { return x && !y; } );
+    }
+    [[nodiscard]] friend auto operator^( range_set const& a, range_set const& b ) -> range_set
+    {
+        return merge( a, b, []( bool const x, bool const y ) { return x != y; } );
+    }
+    auto operator|=( range_set const& rhs ) -> range_set& {
+        return *this = *this | rhs;
+    }
+    auto operator&=( range_set const& rhs ) -> range_set& {
+        return *this = *this & rhs;
+    }
+    auto operator-=( range_set const& rhs ) -> range_set& {
+        return *this = *this - rhs;
+    }
+    auto operator^=( range_set const& rhs ) -> range_set& {
+        return *this = *this ^ rhs;
+    }
+    [[nodiscard]] friend auto operator==( range_set const& a, range_set const& b ) -> bool
+    {
+        return a.bounds_ == b.bounds_;
+    }
+    [[nodiscard]] friend auto operator!=( range_set const& a, range_set const& b ) -> bool
+    {
+        return !( a == b );
+    }
+
+    // iteration over the values of all intervals as one ascending sequence
+    class iterator
+    {   // iterator holds reference to range_set and is invalidated if the set is modified
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = ty_t;
+        using reference = ty_t;
+        using pointer = ty_t*;
+        using iterator_category = std::forward_iterator_tag;
+
+        explicit iterator( range_set const& set, std::size_t const bound ) :
+            set_{ set },
+            bound_{ bound },
+            value_{ bound < set.bounds_.size() ? set.bounds_[ bound ] : ty_t{} }
+        {
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return &set_ == &rhs.set_ && bound_ == rhs.bound_ && value_ == rhs.value_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            if ( ++value_ == set_.bounds_[ bound_ + 1 ] ) {
+                bound_ += 2;
+                value_ = bound_ < set_.bounds_.size() ? set_.bounds_[ bound_ ] : ty_t{};
+            }
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() const -> reference {
+            return value_;
+        }
+
+    private:
+        range_set const& set_;
+        std::size_t bound_{};   // index of the start of the current interval
+        ty_t value_{};
+    };
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, bounds_.size() };
+    }
+
+private:
+    [[nodiscard]] static auto bounds( range< ty_t > const& r ) -> std::pair< ty_t, ty_t >
+    {   // @requires: unit step, intervals are contiguous
+        assert( r.step() == ty_t{ 1 } );
+        return { r.start(), r.stop() };
+    }
+    [[nodiscard]] auto lower( ty_t const& v ) const -> std::size_t
+    {   // index of first boundary >= v
+        return static_cast< std::size_t >( std::lower_bound( bounds_.begin(), bounds_.end(), v ) - bounds_.begin() );
+    }
+    [[nodiscard]] auto upper( ty_t const& v ) const -> std::size_t
+    {   // index of first boundary > v
+        return static_cast< std::size_t >( std::upper_bound( bounds_.begin(), bounds_.end(), v ) - bounds_.begin() );
+    }
+    void replace( std::size_t const p, std::size_t const q, bool const add_lo, ty_t const& lo, bool const add_hi, ty_t const& hi )
+    {   // replace boundaries [p, q) with the optional new boundaries 'lo' and 'hi'
+        auto const added = static_cast< std::size_t >( add_lo ) + static_cast< std::size_t >( add_hi );
+        auto const removed = q - p;
+        if ( added > removed ) {
+            bounds_.insert( bounds_.begin() + static_cast< std::ptrdiff_t >( p ), added - removed, ty_t{} );
+        }
+        else {
+            bounds_.erase( bounds_.begin() + static_cast< std::ptrdiff_t >( p ),
+                           bounds_.begin() + static_cast< std::ptrdiff_t >( p + removed - added ) );
+        }
+        auto at = p;
+        if ( add_lo ) {
+            bounds_[ at++ ] = lo;
+        }
+        if ( add_hi ) {
+            bounds_[ at++ ] = hi;
+        }
+    }
+
+    template < typename op_t >
+    [[nodiscard]] static auto merge( range_set const& a, range_set const& b, op_t const op ) -> range_set
+    {   // sweep both boundary lists, emitting a boundary wherever op( in_a, in_b ) changes
+        auto ret = range_set{};
+        ret.bounds_.reserve( a.bounds_.size() + b.bounds_.size() );
+        auto i = std::size_t{ 0 };
+        auto j = std::size_t{ 0 };
+        auto in = false;
+        while ( i < a.bounds_.size() || j < b.bounds_.size() ) {
+            auto const x = j == b.bounds_.size() || ( i < a.bounds_.size() && a.bounds_[ i ] < b.bounds_[ j ] )
+                         ? a.bounds_[ i ] : b.bounds_[ j ];
+            while ( i < a.bounds_.size() && a.bounds_[ i ] == x ) {
+                ++i;
+            }
+            while ( j < b.bounds_.size() && b.bounds_[ j ] == x ) {
+                ++j;
+            }
+            // an odd number of boundaries passed means x is inside that set
+            auto const now = op( ( i & 1 ) != 0, ( j & 1 ) != 0 );
+            if ( now != in ) {
+                ret.bounds_.push_back( x );
+                in = now;
+            }
+        }
+        return ret;
+    }
+
+    std::vector< ty_t > bounds_;
+};
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_SET_H_
@@ -0,0 +1,79 @@
+// range_stencil.h
+//
+// interior / boundary decomposition of an ndrange for stencil loops
+// the interior holds every point at least 'radius' indices away from all edges, so a
+// stencil kernel can read its neighbours there without bounds checks or clamping.
+// the boundary slabs hold the rest of the domain, disjoint from each other and the interior
+// e.g.
+//     auto const regions = roam::stencil_regions( grid, 1 );
+//     for ( auto const [ y, x ] : regions.interior ) { fast_kernel( y, x ); }
+//     for ( auto const& slab : regions.boundary )
+//         for ( auto const [ y, x ] : slab ) { clamped_kernel( y, x ); }
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_STENCIL_H_
+#define _INC_ROAM_RANGE_STENCIL_H_
+
+#include "range_nd.h"
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+template < typename ty_t, std::size_t dims >
+struct stencil_region_set
+{
+    ndrange< ty_t, dims > interior;
+    // low and high slab of each dimension: boundary[ 2d ] and boundary[ 2d + 1 ]
+    // slab of dimension d spans the interior of dimensions < d, the border of d and all of > d
+    std::array< ndrange< ty_t, dims >, 2 * dims > boundary;
+};
+
+template < typename ty_t, std::size_t dims >
+[[nodiscard]] constexpr auto stencil_regions( ndrange< ty_t, dims > const& domain, std::array< std::ptrdiff_t, dims > const& radius )
+    -> stencil_region_set< ty_t, dims >
+{   // @return interior and boundary slabs for a per dimension stencil radius
+    // @note: when a dimension is shorter than 2 * radius the interior is empty and
+    //        that dimension is covered by its slabs
+    auto lo = std::array< std::ptrdiff_t, dims >{};
+    auto hi = std::array< std::ptrdiff_t, dims >{};
+    for ( auto d = std::size_t{ 0 }; d < dims; ++d ) {
+        // @requires: non-negative radius
+        assert( radius[ d ] >= 0 );
+        auto const n = static_cast< std::ptrdiff_t >( domain.extent( d ).size() );
+        lo[ d ] = radius[ d ] < n ? radius[ d ] : n;
+        hi[ d ] = n - radius[ d ] > lo[ d ] ? n - radius[ d ] : lo[ d ];
+    }
+
+    auto const region = [&]( std::size_t const slab, std::ptrdiff_t const from, std::ptrdiff_t const to ) {
+        // dimensions before 'slab' are clipped to the interior, 'slab' to [ from, to ), the rest are full
+        return ndrange< ty_t, dims >{ detail::make_array< dims >( [&]( std::size_t const d ) {
+            auto const& e = domain.extent( d );
+            return d < slab ? sub_range( e, lo[ d ], hi[ d ] )
+                 : d == slab ? sub_range( e, from, to )
+                 : e;
+        } ) };
+    };
+    return stencil_region_set< ty_t, dims >{
+        region( dims, 0, 0 ),
+        detail::make_array< 2 * dims >( [&]( std::size_t const i ) {
+            auto const d = i / 2;
+            auto const n = static_cast< std::ptrdiff_t >( domain.extent( d ).size() );
+            return i % 2 == 0 ? region( d, 0, lo[ d ] ) : region( d, hi[ d ], n );
+        } )
+    };
+}
+
+template < typename ty_t, std::size_t dims >
+[[nodiscard]] constexpr auto stencil_regions( ndrange< ty_t, dims > const& domain, std::ptrdiff_t const radius )
+    -> stencil_region_set< ty_t, dims >
+{   // @return interior and boundary slabs for the same stencil radius in every dimension
+    return stencil_regions( domain, detail::make_array< dims >( [=]( std::size_t ) { return radius; } ) );
+}
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_STENCIL_H_
@@ -0,0 +1,473 @@
+// range_telemetry.h
+//
+// opt-in trip count telemetry for range loops
+// traced( r ) wraps a loop's range and records, per call site, a histogram of the range's size()
+// and one of the iterations the loop actually ran ( fewer than size() when it breaks early ).
+// the input for choosing simd widths, unroll factors and parallel thresholds from production runs
+// recording is on when ROAM_TELEMETRY is defined ( or for traced< telemetry::enabled > ), otherwise
+// traced( r ) is r itself and compiles to nothing
+// each thread records into its own buffer without locks or read-modify-write atomics, buffers are
+// merged by report() and dumped as json lines at exit, to stderr or the file ROAM_TELEMETRY_FILE.
+// a buffer is about 150KB, the buffer of an exited thread is reused by the next thread that
+// records, so memory follows the threads recording at once rather than every thread ever started
+// e.g.
+//     for ( auto const i : roam::traced( roam::range{ n } ) ) { do_smth( i ); }
+//     // g++ -DROAM_TELEMETRY ... && ./app  ->  {"file":"app.cpp","line":12,...,"size_log2":[0,0,3,41]}
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_TELEMETRY_H_
+#define _INC_ROAM_RANGE_TELEMETRY_H_
+
+#include "range.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#if __cplusplus >= 202002L && __has_include( <source_location> )
+#include <source_location>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+namespace telemetry
+{
+    // recording policies for traced, the default follows ROAM_TELEMETRY
+    struct disabled {};
+    struct enabled {};
+#if defined( ROAM_TELEMETRY )
+    using default_policy = enabled;
+#else
+    using default_policy = disabled;
+#endif
+
+    // histogram buckets: bucket 0 counts empty loops, bucket b counts [ 2^( b - 1 ), 2^b ),
+    // the last bucket everything from 2^31 up
+    inline constexpr std::size_t buckets = 33;
+
+    // call site of a traced loop
+    struct site
+    {
+        char const* file{ "" };
+        char const* function{ "" };
+        std::uint_least32_t line{};
+        std::uint_least32_t column{};
+
+#if __cplusplus >= 202002L && __has_include( <source_location> )
+        [[nodiscard]] static constexpr auto current( std::source_location const loc = std::source_location::current() ) -> site
+        {   // @return the site of the call whose default argument this is
+            return site{ loc.file_name(), loc.function_name(), loc.line(), loc.column() };
+        }
+#else
+        [[nodiscard]] static constexpr auto current( char const* const file = __builtin_FILE(), char const* const function = __builtin_FUNCTION(),
+                                                     std::uint_least32_t const line = __builtin_LINE() ) -> site
+        {   // @return the site of the call whose default argument this is, without a column
+            return site{ file, function, line, 0 };
+        }
+#endif
+    };
+
+    // merged counts of one call site over every thread
+    struct site_report
+    {
+        site where{};
+        std::uint64_t loops{};
+        std::uint64_t size_total{};
+        std::uint64_t iterations_total{};
+        std::array< std::uint64_t, buckets > sizes{};
+        std::array< std::uint64_t, buckets > iterations{};
+    };
+} // telemetry
+
+namespace detail
+{
+    // call sites one thread can record, later sites are counted as dropped
+    inline constexpr std::size_t telemetry_slots = 256;
+
+    struct telemetry_slot
+    {   // written by the owning thread only, counters are atomics so report() may read them live
+        std::atomic< char const* > file{ nullptr };   // published last, null while the slot is free
+        char const* function{};
+        std::uint_least32_t line{};
+        std::uint_least32_t column{};
+        std::atomic< std::uint64_t > loops{};
+        std::atomic< std::uint64_t > size_total{};
+        std::atomic< std::uint64_t > iterations_total{};
+        std::array< std::atomic< std::uint64_t >, telemetry::buckets > sizes{};
+        std::array< std::atomic< std::uint64_t >, telemetry::buckets > iterations{};
+    };
+
+    struct telemetry_buffer
+    {   // one per recording thread, never freed so counts outlive the thread. when the thread exits
+        // the buffer is free and the next thread to record takes it over, counts and call sites included
+        std::array< telemetry_slot, telemetry_slots > slots{};
+        std::atomic< std::uint64_t > dropped{};
+        std::atomic< bool > in_use{ true };
+        telemetry_buffer* next{};
+    };
+
+    // every thread's buffer, a push only list
+    inline std::atomic< telemetry_buffer* > telemetry_head{ nullptr };
+    inline thread_local telemetry_buffer* telemetry_local{ nullptr };
+    inline thread_local bool telemetry_exited{ false };
+
+    struct telemetry_release
+    {   // destroyed at thread exit, frees the thread's buffer for the next thread
+        telemetry_release() = default;
+        telemetry_release( telemetry_release const& ) = delete;
+        auto operator=( telemetry_release const& ) -> telemetry_release& = delete;
+        ~telemetry_release()
+        {
+            if ( telemetry_local != nullptr ) {
+                // release: the counts written by this thread are seen by the thread taking the buffer over
+                telemetry_local->in_use.store( false, std::memory_order_release );
+                telemetry_local = nullptr;
+            }
+            telemetry_exited = true;
+        }
+    };
+
+    inline void telemetry_add( std::atomic< std::uint64_t >& counter, std::uint64_t const n )
+    {   // single writer, a relaxed load and store rather than a locked read-modify-write
+        counter.store( counter.load( std::memory_order_relaxed ) + n, std::memory_order_relaxed );
+    }
+
+    [[nodiscard]] inline auto telemetry_bucket( std::uint64_t const n ) -> std::size_t
+    {   // @return 0 for 0, else 1 + floor( log2( n ) ), capped at the last bucket
+#if defined( __GNUC__ ) || defined( __clang__ )
+        auto const width = n == 0 ? std::size_t{ 0 } : static_cast< std::size_t >( 64 - __builtin_clzll( n ) );
+#else
+        auto width = std::size_t{ 0 };
+        for ( auto v = n; v != 0; v >>= 1 ) {
+            ++width;
+        }
+#endif
+        return width < telemetry::buckets ? width : telemetry::buckets - 1;
+    }
+
+    inline void telemetry_dump_at_exit();
+
+    [[nodiscard]] inline auto telemetry_buffer_acquire() -> telemetry_buffer*
+    {   // @return the free buffer of an exited thread, or a new one pushed onto the list
+        for ( auto* b = telemetry_head.load( std::memory_order_acquire ); b != nullptr; b = b->next ) {
+            auto in_use = false;
+            if ( !b->in_use.load( std::memory_order_relaxed ) &&
+                 b->in_use.compare_exchange_strong( in_use, true, std::memory_order_acquire, std::memory_order_relaxed ) ) {
+                return b;
+            }
+        }
+        auto* const buffer = new telemetry_buffer{};
+        auto* head = telemetry_head.load( std::memory_order_relaxed );
+        do {
+            buffer->next = head;
+        } while ( !telemetry_head.compare_exchange_weak( head, buffer, std::memory_order_release, std::memory_order_relaxed ) );
+        if ( buffer->next == nullptr ) {
+            // exactly one buffer ends the list, its thread registers the dump
+            std::atexit( telemetry_dump_at_exit );
+        }
+        return buffer;
+    }
+
+    [[nodiscard]] inline auto telemetry_buffer_local() -> telemetry_buffer&
+    {   // @return this thread's buffer, taken on first use and freed at thread exit
+        // @note: a loop traced after the thread's thread_local objects are destroyed keeps its buffer
+        if ( telemetry_local == nullptr ) {
+            telemetry_local = telemetry_buffer_acquire();
+            if ( !telemetry_exited ) {
+                thread_local telemetry_release const release{};
+            }
+        }
+        return *telemetry_local;
+    }
+
+    [[nodiscard]] inline auto telemetry_slot_for( telemetry::site const& where ) -> telemetry_slot*
+    {   // @return the slot of 'where' in this thread's buffer, nullptr when the buffer is full
+        auto& buffer = telemetry_buffer_local();
+        auto const hash = ( reinterpret_cast< std::uintptr_t >( where.file ) >> 3 ) ^ ( where.line * 0x9e3779b1u ) ^ where.column;
+        for ( auto probe = std::size_t{ 0 }; probe < telemetry_slots; ++probe ) {
+            auto& slot = buffer.slots[ ( hash + probe ) % telemetry_slots ];
+            auto const* const file = slot.file.load( std::memory_order_relaxed );
+            if ( file == nullptr ) {
+                slot.function = where.function;
+                slot.line = where.line;
+                slot.column = where.column;
+                slot.file.store( where.file, std::memory_order_release );
+                return &slot;
+            }
+            if ( file == where.file && slot.line == where.line && slot.column == where.column ) {
+                return &slot;
+            }
+        }
+        telemetry_add( buffer.dropped, 1 );
+        return nullptr;
+    }
+
+    inline void telemetry_record_size( telemetry_slot& slot, std::uint64_t const size )
+    {
+        telemetry_add( slot.loops, 1 );
+        telemetry_add( slot.size_total, size );
+        telemetry_add( slot.sizes[ telemetry_bucket( size ) ], 1 );
+    }
+
+    inline void telemetry_record_iterations( telemetry_slot& slot, std::uint64_t const iterations )
+    {
+        telemetry_add( slot.iterations_total, iterations );
+        telemetry_add( slot.iterations[ telemetry_bucket( iterations ) ], 1 );
+    }
+
+    template < typename range_t, typename = void >
+    struct has_size : std::false_type {};
+    template < typename range_t >
+    struct has_size< range_t, std::void_t< decltype( std::declval< range_t const& >().size() ) > > : std::true_type {};
+
+    inline void telemetry_print_string( std::FILE* const out, char const* s )
+    {   // json string body, escaping quotes and backslashes
+        for ( ; *s != '\0'; ++s ) {
+            if ( *s == '"' || *s == '\\' ) {
+                std::fputc( '\\', out );
+            }
+            std::fputc( *s, out );
+        }
+    }
+
+    inline void telemetry_print_histogram( std::FILE* const out, std::array< std::uint64_t, telemetry::buckets > const& h )
+    {   // trailing empty buckets left out
+        auto n = h.size();
+        while ( n > 1 && h[ n - 1 ] == 0 ) {
+            --n;
+        }
+        std::fputc( '[', out );
+        for ( auto i = std::size_t{ 0 }; i < n; ++i ) {
+            std::fprintf( out, i == 0 ? "%llu" : ",%llu", static_cast< unsigned long long >( h[ i ] ) );
+        }
+        std::fputc( ']', out );
+    }
+} // detail
+
+namespace telemetry
+{
+    [[nodiscard]] inline auto report() -> std::vector< site_report >
+    {   // @return every recorded call site merged over all threads, in no particular order
+        // @note: counts of loops running concurrently may be partially included
+        auto ret = std::vector< site_report >{};
+        for ( auto const* b = detail::telemetry_head.load( std::memory_order_acquire ); b != nullptr; b = b->next ) {
+            for ( auto const& slot : b->slots ) {
+                auto const* const file = slot.file.load( std::memory_order_acquire );
+                if ( file == nullptr ) {
+                    continue;
+                }
+                auto it = ret.begin();
+                while ( it != ret.end() && !( it->where.line == slot.line && it->where.column == slot.column &&
+                                              std::strcmp( it->where.file, file ) == 0 && std::strcmp( it->where.function, slot.function ) == 0 ) ) {
+                    ++it;
+                }
+                if ( it == ret.end() ) {
+                    it = ret.insert( ret.end(), site_report{ site{ file, slot.function, slot.line, slot.column } } );
+                }
+                it->loops += slot.loops.load( std::memory_order_relaxed );
+                it->size_total += slot.size_total.load( std::memory_order_relaxed );
+                it->iterations_total += slot.iterations_total.load( std::memory_order_relaxed );
+                for ( auto i = std::size_t{ 0 }; i < buckets; ++i ) {
+                    it->sizes[ i ] += slot.sizes[ i ].load( std::memory_order_relaxed );
+                    it->iterations[ i ] += slot.iterations[ i ].load( std::memory_order_relaxed );
+                }
+            }
+        }
+        return ret;
+    }
+
+    [[nodiscard]] inline auto dropped() -> std::uint64_t
+    {   // @return loops not recorded because their thread's buffer had no free slot
+        auto ret = std::uint64_t{ 0 };
+        for ( auto const* b = detail::telemetry_head.load( std::memory_order_acquire ); b != nullptr; b = b->next ) {
+            ret += b->dropped.load( std::memory_order_relaxed );
+        }
+        return ret;
+    }
+
+    [[nodiscard]] inline auto buffers() -> std::size_t
+    {   // @return thread buffers allocated, the most threads that recorded at the same time
+        auto ret = std::size_t{ 0 };
+        for ( auto const* b = detail::telemetry_head.load( std::memory_order_acquire ); b != nullptr; b = b->next ) {
+            ++ret;
+        }
+        return ret;
+    }
+
+    inline void reset()
+    {   // zero every count, call sites stay registered
+        // @note: counts recorded concurrently may survive or be lost
+        for ( auto* b = detail::telemetry_head.load( std::memory_order_acquire ); b != nullptr; b = b->next ) {
+            for ( auto& slot : b->slots ) {
+                slot.loops.store( 0, std::memory_order_relaxed );
+                slot.size_total.store( 0, std::memory_order_relaxed );
+                slot.iterations_total.store( 0, std::memory_order_relaxed );
+                for ( auto i = std::size_t{ 0 }; i < buckets; ++i ) {
+                    slot.sizes[ i ].store( 0, std::memory_order_relaxed );
+                    slot.iterations[ i ].store( 0, std::memory_order_relaxed );
+                }
+            }
+            b->dropped.store( 0, std::memory_order_relaxed );
+        }
+    }
+
+    inline void dump( std::FILE* const out )
+    {   // one json line per call site with loops, e.g.
+        // {"file":"a.cpp","line":12,"column":5,"function":"f","loops":3,"size_total":103,"iterations_total":54,
+        //  "size_log2":[1,0,1,0,0,0,0,1],"iterations_log2":[1,0,1,0,0,0,1]}
+        for ( auto const& r : report() ) {
+            if ( r.loops == 0 ) {
+                continue;
+            }
+            std::fputs( "{\"file\":\"", out );
+            detail::telemetry_print_string( out, r.where.file );
+            std::fprintf( out, "\",\"line\":%lu,\"column\":%lu,\"function\":\"", static_cast< unsigned long >( r.where.line ),
+                          static_cast< unsigned long >( r.where.column ) );
+            detail::telemetry_print_string( out, r.where.function );
+            std::fprintf( out, "\",\"loops\":%llu,\"size_total\":%llu,\"iterations_total\":%llu,\"size_log2\":", static_cast< unsigned long long >( r.loops ),
+                          static_cast< unsigned long long >( r.size_total ), static_cast< unsigned long long >( r.iterations_total ) );
+            detail::telemetry_print_histogram( out, r.sizes );
+            std::fputs( ",\"iterations_log2\":", out );
+            detail::telemetry_print_histogram( out, r.iterations );
+            std::fputs( "}\n", out );
+        }
+        if ( auto const n = dropped(); n != 0 ) {
+            std::fprintf( out, "{\"dropped_loops\":%llu}\n", static_cast< unsigned long long >( n ) );
+        }
+        std::fflush( out );
+    }
+} // telemetry
+
+namespace detail
+{
+    inline void telemetry_dump_at_exit()
+    {   // to ROAM_TELEMETRY_FILE when set, stderr otherwise
+        auto const* const path = std::getenv( "ROAM_TELEMETRY_FILE" );
+        if ( path == nullptr || *path == '\0' ) {
+            telemetry::dump( stderr );
+            return;
+        }
+        if ( auto* const out = std::fopen( path, "w" ); out != nullptr ) {
+            telemetry::dump( out );
+            std::fclose( out );
+        }
+    }
+} // detail
+
+// a range whose loop is recorded, size() when the loop begins and iterations when it ends
+template < typename range_t >
+class traced_view
+{
+public:
+    using base_iterator = decltype( std::declval< range_t& >().begin() );
+
+    explicit traced_view( range_t&& r, telemetry::site const& where ) :
+        range_{ std::forward< range_t >( r ) },
+        where_{ where }
+    {
+    }
+    traced_view( traced_view const& ) = delete;
+    auto operator=( traced_view const& ) -> traced_view& = delete;
+    ~traced_view()
+    {
+        if ( slot_ != nullptr ) {
+            detail::telemetry_record_iterations( *slot_, iterations_ );
+        }
+    }
+
+    class iterator
+    {   // counts dereferences, one per loop body, in the view it came from
+    public:
+        using difference_type = typename std::iterator_traits< base_iterator >::difference_type;
+        using value_type = typename std::iterator_traits< base_iterator >::value_type;
+        using reference = typename std::iterator_traits< base_iterator >::reference;
+        using pointer = typename std::iterator_traits< base_iterator >::pointer;
+        using iterator_category = std::forward_iterator_tag;
+
+        explicit iterator( base_iterator const& it, std::uint64_t* const count ) :
+            it_{ it },
+            count_{ count }
+        {
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return it_ == rhs.it_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            ++it_;
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() -> reference {
+            ++*count_;
+            return *it_;
+        }
+
+    private:
+        base_iterator it_;
+        std::uint64_t* count_{};
+    };
+
+    [[nodiscard]] auto begin() -> iterator
+    {   // @note: starts a recorded loop, a view is meant for one loop
+        if ( slot_ == nullptr ) {
+            slot_ = detail::telemetry_slot_for( where_ );
+            if ( slot_ != nullptr ) {
+                auto size = std::uint64_t{ 0 };
+                if constexpr ( detail::has_size< std::remove_reference_t< range_t > >::value ) {
+                    size = static_cast< std::uint64_t >( range_.size() );
+                }
+                detail::telemetry_record_size( *slot_, size );
+            }
+        }
+        return iterator{ range_.begin(), &iterations_ };
+    }
+    [[nodiscard]] auto end() -> iterator {
+        return iterator{ range_.end(), &iterations_ };
+    }
+
+private:
+    range_t range_;
+    telemetry::site where_;
+    detail::telemetry_slot* slot_{};
+    std::uint64_t iterations_{};
+};
+
+template < typename policy_t = telemetry::default_policy, typename range_t >
+[[nodiscard]] constexpr decltype( auto ) traced( range_t&& r, [[maybe_unused]] telemetry::site const where = telemetry::site::current() )
+{   // @return 'r' itself when disabled, a traced_view recording the loop at the call site otherwise
+    // lvalues are referenced and rvalues moved in, so the temporary of 'for ( i : traced( range{ n } ) )'
+    // lives as long as the loop
+    // @example: for ( auto const i : traced( range{ n } ) ) {}
+    if constexpr ( std::is_same_v< policy_t, telemetry::enabled > ) {
+        return traced_view< range_t >{ std::forward< range_t >( r ), where };
+    }
+    else {
+        static_assert( std::is_same_v< policy_t, telemetry::disabled >, "traced policy is telemetry::enabled or telemetry::disabled" );
+        return static_cast< range_t >( std::forward< range_t >( r ) );
+    }
+}
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_TELEMETRY_H_
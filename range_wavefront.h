@@ -0,0 +1,294 @@
+// range_wavefront.h
+//
+// anti-diagonal ( wavefront ) traversal of a 2d grid for dynamic programming tables
+// where cell ( r, c ) depends on ( r - 1, c ), ( r, c - 1 ) and ( r - 1, c - 1 ).
+// all cells of one anti-diagonal are independent of each other
+// e.g.
+//     for ( auto const& diag : roam::wavefront{ grid } )
+//         for ( auto const [ r, c ] : diag ) {}
+//     roam::parallel_wavefront( roam::blocked_wavefront{ grid, 64, 64 }, 8, kernel );
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_WAVEFRONT_H_
+#define _INC_ROAM_RANGE_WAVEFRONT_H_
+
+#include "range_nd.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+// cell wavefront, diagonal 'd' holds the cells whose row and column indices sum to 'd'
+template < typename ty_t >
+class wavefront
+{
+public:
+    // one anti-diagonal, ordered by increasing row index
+    class diagonal
+    {
+    public:
+        using value_type = std::array< ty_t, 2 >;
+
+        constexpr explicit diagonal( ndrange2d< ty_t > const& grid, std::ptrdiff_t const row, std::ptrdiff_t const col, std::ptrdiff_t const count ) :
+            grid_{ grid },
+            row_{ row },
+            col_{ col },
+            count_{ count }
+        {
+        }
+
+        [[nodiscard]] constexpr auto size() const -> std::size_t
+        {
+            return static_cast< std::size_t >( count_ );
+        }
+        [[nodiscard]] constexpr auto empty() const -> bool
+        {
+            return 0 == count_;
+        }
+        [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx_in ) const -> value_type
+        {   // @return ( row, col ) grid values of cell 'idx' on the diagonal
+            auto const idx = idx_in >= 0 ? idx_in : count_ + idx_in;
+            // @requires: valid index
+            assert( 0 <= idx && idx < count_ );
+            return value_type{ grid_.extent( 0 )[ row_ + idx ], grid_.extent( 1 )[ col_ - idx ] };
+        }
+
+        using iterator = detail::index_iterator< diagonal >;
+
+        [[nodiscard]] auto begin() const -> iterator {
+            return iterator{ *this, 0 };
+        }
+        [[nodiscard]] auto end() const -> iterator {
+            return iterator{ *this, count_ };
+        }
+
+    private:
+        ndrange2d< ty_t > grid_;
+        std::ptrdiff_t row_{};   // index of first cell
+        std::ptrdiff_t col_{};
+        std::ptrdiff_t count_{};
+    };
+
+    constexpr explicit wavefront( ndrange2d< ty_t > const& grid ) :
+        grid_{ grid }
+    {   // @example: wavefront{ ndrange{ range{ n + 1 }, range{ m + 1 } } }
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {   // @return number of diagonals, rows + cols - 1
+        auto const rows = grid_.extent( 0 ).size();
+        auto const cols = grid_.extent( 1 ).size();
+        return ( rows == 0 || cols == 0 ) ? 0 : rows + cols - 1;
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return 0 == size();
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const d_in ) const -> diagonal
+    {   // @return anti-diagonal 'd', O(1)
+        auto const rows = static_cast< std::ptrdiff_t >( grid_.extent( 0 ).size() );
+        auto const cols = static_cast< std::ptrdiff_t >( grid_.extent( 1 ).size() );
+        auto const d = d_in >= 0 ? d_in : static_cast< std::ptrdiff_t >( size() ) + d_in;
+        // @requires: valid index
+        assert( 0 <= d && d < rows + cols - 1 );
+        auto const row = d < cols ? 0 : d - cols + 1;
+        auto const last = d < rows ? d : rows - 1;
+        return diagonal{ grid_, row, d - row, last - row + 1 };
+    }
+
+    using iterator = detail::index_iterator< wavefront >;
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, static_cast< std::ptrdiff_t >( size() ) };
+    }
+
+private:
+    ndrange2d< ty_t > grid_;
+};
+
+template < typename ty_t >
+wavefront( ndrange2d< ty_t > const& ) -> wavefront< ty_t >;
+
+// tile wavefront, the grid is cut into tiles which are visited in anti-diagonal order
+// so each tile can be processed as a cache resident block
+template < typename ty_t >
+class blocked_wavefront
+{
+public:
+    class diagonal
+    {
+    public:
+        using value_type = ndrange2d< ty_t >;
+
+        constexpr explicit diagonal( blocked_wavefront const& wave, typename wavefront< std::ptrdiff_t >::diagonal const& tiles ) :
+            wave_{ wave },
+            tiles_{ tiles }
+        {
+        }
+
+        [[nodiscard]] constexpr auto size() const -> std::size_t
+        {
+            return tiles_.size();
+        }
+        [[nodiscard]] constexpr auto empty() const -> bool
+        {
+            return tiles_.empty();
+        }
+        [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx ) const -> value_type
+        {   // @return sub grid of tile 'idx' on the diagonal
+            auto const [ tr, tc ] = tiles_[ idx ];
+            return wave_.tile( tr, tc );
+        }
+
+        using iterator = detail::index_iterator< diagonal >;
+
+        [[nodiscard]] auto begin() const -> iterator {
+            return iterator{ *this, 0 };
+        }
+        [[nodiscard]] auto end() const -> iterator {
+            return iterator{ *this, static_cast< std::ptrdiff_t >( size() ) };
+        }
+
+    private:
+        blocked_wavefront const& wave_;
+        typename wavefront< std::ptrdiff_t >::diagonal tiles_;
+    };
+
+    constexpr explicit blocked_wavefront( ndrange2d< ty_t > const& grid, std::ptrdiff_t const tile_rows, std::ptrdiff_t const tile_cols ) :
+        grid_{ grid },
+        tile_rows_{ tile_rows },
+        tile_cols_{ tile_cols },
+        tiles_{ ndrange{ range{ blocks( grid.extent( 0 ), tile_rows ) }, range{ blocks( grid.extent( 1 ), tile_cols ) } } }
+    {   // @requires: positive tile size
+        assert( tile_rows_ > 0 && tile_cols_ > 0 );
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {   // @return number of tile diagonals
+        return tiles_.size();
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return tiles_.empty();
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const d ) const -> diagonal
+    {
+        return diagonal{ *this, tiles_[ d ] };
+    }
+    [[nodiscard]] constexpr auto tile( std::ptrdiff_t const tr, std::ptrdiff_t const tc ) const -> ndrange2d< ty_t >
+    {   // @return sub grid of tile ( tr, tc ), edge tiles may be smaller
+        return ndrange2d< ty_t >{ tile_extent( grid_.extent( 0 ), tr, tile_rows_ ), tile_extent( grid_.extent( 1 ), tc, tile_cols_ ) };
+    }
+
+    using iterator = detail::index_iterator< blocked_wavefront >;
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, static_cast< std::ptrdiff_t >( size() ) };
+    }
+
+private:
+    [[nodiscard]] static constexpr auto blocks( range< ty_t > const& r, std::ptrdiff_t const b ) -> std::ptrdiff_t
+    {
+        return ( static_cast< std::ptrdiff_t >( r.size() ) + b - 1 ) / b;
+    }
+    [[nodiscard]] static constexpr auto tile_extent( range< ty_t > const& r, std::ptrdiff_t const t, std::ptrdiff_t const b ) -> range< ty_t >
+    {
+        auto const n = static_cast< std::ptrdiff_t >( r.size() );
+        auto const lo = t * b;
+        return sub_range( r, lo, n - lo < b ? n : lo + b );
+    }
+
+    ndrange2d< ty_t > grid_;
+    std::ptrdiff_t tile_rows_{};
+    std::ptrdiff_t tile_cols_{};
+    wavefront< std::ptrdiff_t > tiles_;
+};
+
+template < typename ty_t >
+blocked_wavefront( ndrange2d< ty_t > const&, std::ptrdiff_t, std::ptrdiff_t ) -> blocked_wavefront< ty_t >;
+
+namespace detail
+{
+    // reusable thread barrier
+    class barrier
+    {
+    public:
+        explicit barrier( std::size_t const count ) :
+            count_{ count }
+        {
+        }
+
+        void arrive_and_wait()
+        {
+            auto lock = std::unique_lock< std::mutex >{ mutex_ };
+            auto const generation = generation_;
+            if ( ++arrived_ == count_ ) {
+                arrived_ = 0;
+                ++generation_;
+                cv_.notify_all();
+                return;
+            }
+            cv_.wait( lock, [&] { return generation != generation_; } );
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::size_t const count_{};
+        std::size_t arrived_{};
+        std::size_t generation_{};
+    };
+} // detail
+
+// parallel wavefront driver
+// diagonals are processed in order, the elements of each diagonal are split evenly across
+// 'thread_count' threads ( the calling thread included ) which synchronize between diagonals
+// @example: parallel_wavefront( wavefront{ grid }, 8, [&]( auto const& cell ) { ... } );
+// @note: 'fn' is called concurrently and must not throw
+template < typename wave_t, typename fn_t >
+void parallel_wavefront( wave_t const& wave, std::size_t const thread_count, fn_t&& fn )
+{
+    auto const count = thread_count > 0 ? thread_count : std::size_t{ 1 };
+    auto const diagonals = static_cast< std::ptrdiff_t >( wave.size() );
+    auto sync = detail::barrier{ count };
+    auto const worker = [&]( std::size_t const t ) {
+        for ( auto d = std::ptrdiff_t{ 0 }; d < diagonals; ++d ) {
+            auto const diag = wave[ d ];
+            auto const n = diag.size();
+            auto const lo = static_cast< std::ptrdiff_t >( n * t / count );
+            auto const hi = static_cast< std::ptrdiff_t >( n * ( t + 1 ) / count );
+            for ( auto k = lo; k < hi; ++k ) {
+                fn( diag[ k ] );
+            }
+            sync.arrive_and_wait();
+        }
+    };
+
+    auto pool = std::vector< std::thread >{};
+    pool.reserve( count - 1 );
+    for ( auto t = std::size_t{ 1 }; t < count; ++t ) {
+        pool.emplace_back( worker, t );
+    }
+    worker( 0 );
+    for ( auto& th : pool ) {
+        th.join();
+    }
+}
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_WAVEFRONT_H_
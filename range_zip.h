@@ -0,0 +1,149 @@
+// range_zip.h
+//
+// index + element iteration over contiguous containers with the bounds check hoisted
+// out of the loop: every container is checked once to cover the range, elements are
+// then read through raw pointers
+// e.g.
+//     for ( auto const [ i, v ] : roam::enumerate( vec ) ) {}
+//     for ( auto const [ i, a, b ] : roam::zip( roam::range{ 0, n, 2 }, va, vb ) ) {}
+//=============================================================================
+
+#ifndef _INC_ROAM_RANGE_ZIP_H_
+#define _INC_ROAM_RANGE_ZIP_H_
+
+#include "range.h"
+
+#include <iterator>    // for std::size / std::data
+#include <tuple>
+#include <utility>     // for std::index_sequence
+
+//-----------------------------------------------------------------------------
+
+namespace roam
+{
+
+// @utility: test every value of a range is a valid index of container 'c'
+template < typename ty_t, typename policy_t, typename con_t >
+[[nodiscard]] constexpr auto covers( con_t const& c, range< ty_t, policy_t > const& r ) -> bool
+{   // @example: covers( std::vector< int >( 5 ), range{ 0, 5, 2 } ) == true
+    static_assert( std::is_integral_v< ty_t >, "container indices must be integral" );
+    if ( r.empty() ) {
+        return true;
+    }
+    auto const first = r[ 0 ];
+    auto const last = r[ -1 ];
+    auto const lo = first < last ? first : last;
+    auto const hi = first < last ? last : first;
+    return !( lo < ty_t{} ) && static_cast< std::size_t >( hi ) < std::size( c );
+}
+
+// zipped range: yields std::tuple< index, element&... >
+template < typename ty_t, typename... elem_t >
+class zip_range
+{
+public:
+    using value_type = std::tuple< ty_t, elem_t&... >;
+
+    constexpr explicit zip_range( range< ty_t > const& r, elem_t*... data ) :
+        range_{ r },
+        data_{ data... }
+    {
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t
+    {
+        return range_.size();
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool
+    {
+        return range_.empty();
+    }
+    [[nodiscard]] constexpr auto operator[]( std::ptrdiff_t const idx ) const -> value_type
+    {
+        return make( range_[ idx ], std::index_sequence_for< elem_t... >{} );
+    }
+
+    // iteration
+    // @note: the iterator steps with the range's own iterator, like a range loop without overflow
+    //        when the range ends within one step of the type's limit
+    class iterator
+    {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::tuple< ty_t, elem_t&... >;
+        using reference = value_type;
+        using pointer = value_type*;
+        using iterator_category = std::forward_iterator_tag;
+
+        explicit iterator( zip_range const& zip, std::ptrdiff_t const& idx ) :
+            zip_{ zip },
+            it_{ zip.range_, idx }
+        {
+        }
+
+        [[nodiscard]] auto operator==( iterator const& rhs ) const -> bool {
+            return it_ == rhs.it_;
+        }
+        [[nodiscard]] auto operator!=( iterator const& rhs ) const -> bool {
+            return !( *this == rhs );
+        }
+
+        auto operator++() -> iterator& {
+            ++it_;
+            return *this;
+        }
+        auto operator++( int ) -> iterator {
+            auto const ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        [[nodiscard]] auto operator*() -> reference {
+            return zip_.make( *it_, std::index_sequence_for< elem_t... >{} );
+        }
+
+    private:
+        zip_range const& zip_;
+        typename range< ty_t >::iterator it_;
+    };
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return iterator{ *this, 0 };
+    }
+    [[nodiscard]] auto end() const -> iterator {
+        return iterator{ *this, gsl::narrow< std::ptrdiff_t >( size() ) };
+    }
+
+private:
+    template < std::size_t... is >
+    [[nodiscard]] constexpr auto make( ty_t const& i, std::index_sequence< is... > ) const -> value_type
+    {   // unchecked, coverage was validated at construction
+        return value_type{ i, std::get< is >( data_ )[ i ]... };
+    }
+
+    range< ty_t > range_;
+    std::tuple< elem_t*... > data_;
+};
+
+template < typename ty_t, typename policy_t, typename... con_t >
+[[nodiscard]] constexpr auto zip( range< ty_t, policy_t > const& r, con_t&... c )
+{   // @return ( index, element&... ) for every index of 'r'
+    // @requires: every container covers the range, checked once here and reported through the
+    //            range's policy, a throwing range keeps the check with NDEBUG
+    // @note: containers are referenced, not copied, and must outlive the zip
+    detail::require< policy_t, out_of_range_error >( ( covers( c, r ) && ... ), "zip container does not cover the range" );
+    return zip_range< ty_t, std::remove_pointer_t< decltype( std::data( c ) ) >... >{ range< ty_t >{ r }, std::data( c )... };
+}
+
+template < typename con_t >
+[[nodiscard]] constexpr auto enumerate( con_t& c )
+{   // @return ( index, element& ) for every element of 'c'
+    // @note: the range is the container's size, zip's coverage check always holds
+    return zip( range{ std::size( c ) }, c );
+}
+
+} // roam
+
+//-----------------------------------------------------------------------------
+
+#endif // _INC_ROAM_RANGE_ZIP_H_